@@ -26,6 +26,7 @@ public class GuidFixer : ModuleRules
 			new string[]
 			{
 				"Core",
+				"GuidFixerCore",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -43,6 +44,11 @@ public class GuidFixer : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"AssetRegistry",
+				"DataValidation",
+				"GuidFixerRuntime",
+				"SourceControl",
+				"MeshDescription",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
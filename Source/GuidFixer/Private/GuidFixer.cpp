@@ -3,13 +3,53 @@
 #include "GuidFixer.h"
 #include "GuidFixerStyle.h"
 #include "GuidFixerCommands.h"
+#include "GuidFixerImpact.h"
+#include "GuidFixerAssetTags.h"
+#include "GuidFixerPayloadGuard.h"
+#include "GuidFixerCookMonitor.h"
+#include "GuidFixerObjectSources.h"
+#include "GuidFixerSourceControl.h"
+#include "GuidFixerTrackedGuid.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Containers/Ticker.h"
+#include "CookOnTheSide/CookOnTheFlyServer.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EditorFramework/AssetImportData.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture.h"
+#include "Engine/World.h"
+#include "Hash/Blake3.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInterface.h"
 #include "Misc/MessageDialog.h"
+#include "Sound/SoundWave.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/UObjectHash.h"
 #include "ToolMenus.h"
 
+#include <algorithm>
+
 static const FName GuidFixerTabName("GuidFixer");
 
+static int32 GGuidFixerPreSaveCheck = 1;
+static FAutoConsoleVariableRef CVarGuidFixerPreSaveCheck(
+	TEXT("GuidFixer.PreSaveCheck"),
+	GGuidFixerPreSaveCheck,
+	TEXT("Checks the tracked GUIDs of packages against the GUID index right before they are saved.\n")
+	TEXT("0: off, 1: log collisions, 2: also regenerate colliding GUIDs that may be modified once the save is done."));
+
 #define LOCTEXT_NAMESPACE "FGuidFixerModule"
 
+FGuidFixerModule::FGuidFixerModule()
+{
+}
+
+FGuidFixerModule::~FGuidFixerModule()
+{
+}
+
 void FGuidFixerModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -19,6 +59,8 @@ void FGuidFixerModule::StartupModule()
 
 	FGuidFixerCommands::Register();
 
+	FGuidFixerAssetTags::Initialize();
+
 	FixMaterialGuidsCommands = MakeShareable(new FUICommandList);
 
 	FixMaterialGuidsCommands->MapAction(
@@ -40,6 +82,55 @@ void FGuidFixerModule::StartupModule()
 		FExecuteAction::CreateRaw(this, &FGuidFixerModule::FixEmptyTextureGuids),
 		FCanExecuteAction());
 
+	FixSoundWaveGuidsCommands = MakeShareable(new FUICommandList);
+
+	FixSoundWaveGuidsCommands->MapAction(
+		FGuidFixerCommands::Get().FixSoundWaveGuids,
+		FExecuteAction::CreateRaw(this, &FGuidFixerModule::FixSoundWaveGuids),
+		FCanExecuteAction());
+
+	FixStaticMeshGuidsCommands = MakeShareable(new FUICommandList);
+
+	FixStaticMeshGuidsCommands->MapAction(
+		FGuidFixerCommands::Get().FixStaticMeshGuids,
+		FExecuteAction::CreateRaw(this, &FGuidFixerModule::FixStaticMeshGuids),
+		FCanExecuteAction());
+
+	FixGraphNodeGuidsCommands = MakeShareable(new FUICommandList);
+
+	FixGraphNodeGuidsCommands->MapAction(
+		FGuidFixerCommands::Get().FixGraphNodeGuids,
+		FExecuteAction::CreateRaw(this, &FGuidFixerModule::FixGraphNodeGuids),
+		FCanExecuteAction());
+
+	FixLevelBuildDataIdsCommands = MakeShareable(new FUICommandList);
+
+	FixLevelBuildDataIdsCommands->MapAction(
+		FGuidFixerCommands::Get().FixLevelBuildDataIds,
+		FExecuteAction::CreateRaw(this, &FGuidFixerModule::FixLevelBuildDataIds),
+		FCanExecuteAction());
+
+	FindAssetRegistryCollisionsCommands = MakeShareable(new FUICommandList);
+
+	FindAssetRegistryCollisionsCommands->MapAction(
+		FGuidFixerCommands::Get().FindAssetRegistryCollisions,
+		FExecuteAction::CreateRaw(this, &FGuidFixerModule::FindAssetRegistryCollisions),
+		FCanExecuteAction());
+
+	RebuildGuidIndexCommands = MakeShareable(new FUICommandList);
+
+	RebuildGuidIndexCommands->MapAction(
+		FGuidFixerCommands::Get().RebuildGuidIndex,
+		FExecuteAction::CreateRaw(this, &FGuidFixerModule::RebuildGuidIndex),
+		FCanExecuteAction());
+
+	Index.Open();
+	CookMonitor = MakeUnique<FGuidFixerCookMonitor>();
+	FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FGuidFixerModule::OnObjectModified);
+	UPackage::PreSavePackageWithContextEvent.AddRaw(this, &FGuidFixerModule::OnPackagePreSave);
+	UPackage::PackageSavedWithContextEvent.AddRaw(this, &FGuidFixerModule::OnPackageSaved);
+	UE::Cook::FDelegates::CookByTheBookFinished.AddRaw(this, &FGuidFixerModule::OnCookFinished);
+
 
 	UToolMenus::RegisterStartupCallback(
 		FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FGuidFixerModule::RegisterMenus));
@@ -50,10 +141,30 @@ void FGuidFixerModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 
+	UE::Cook::FDelegates::CookByTheBookFinished.RemoveAll(this);
+	UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+	UPackage::PreSavePackageWithContextEvent.RemoveAll(this);
+	if (FixSavedGuidsHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FixSavedGuidsHandle);
+		FixSavedGuidsHandle.Reset();
+	}
+	FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
+	Index.Close();
+
+	// A cook that never reported finishing, such as a cook commandlet that exited early, still gets what it saw written
+	if (CookMonitor->GetNumCookedPackages() > 0)
+	{
+		CookMonitor->WriteReport();
+	}
+	CookMonitor.Reset();
+
 	UToolMenus::UnRegisterStartupCallback(this);
 
 	UToolMenus::UnregisterOwner(this);
 
+	FGuidFixerAssetTags::Shutdown();
+
 	FGuidFixerStyle::Shutdown();
 
 	FGuidFixerCommands::Unregister();
@@ -70,91 +181,569 @@ void FGuidFixerModule::RegisterMenus()
 		Section.AddMenuEntryWithCommandList(FGuidFixerCommands::Get().FixMaterialGuids, FixMaterialGuidsCommands);
 		Section.AddMenuEntryWithCommandList(FGuidFixerCommands::Get().FixTextureGuids, FixTextureGuidsCommands);
 		Section.AddMenuEntryWithCommandList(FGuidFixerCommands::Get().FixEmptyTextureGuids, FixEmptyTextureGuidsCommands);
+		Section.AddMenuEntryWithCommandList(FGuidFixerCommands::Get().FixSoundWaveGuids, FixSoundWaveGuidsCommands);
+		Section.AddMenuEntryWithCommandList(FGuidFixerCommands::Get().FixStaticMeshGuids, FixStaticMeshGuidsCommands);
+		Section.AddMenuEntryWithCommandList(FGuidFixerCommands::Get().FixGraphNodeGuids, FixGraphNodeGuidsCommands);
+		Section.AddMenuEntryWithCommandList(FGuidFixerCommands::Get().FixLevelBuildDataIds, FixLevelBuildDataIdsCommands);
+		Section.AddMenuEntryWithCommandList(FGuidFixerCommands::Get().FindAssetRegistryCollisions, FindAssetRegistryCollisionsCommands);
+		Section.AddMenuEntryWithCommandList(FGuidFixerCommands::Get().RebuildGuidIndex, RebuildGuidIndexCommands);
 	}
 }
 
-template<typename T>
-bool FGuidFixerModule::ShouldModify(T* Object) const
+void FGuidFixerModule::OnObjectModified(UObject* Object)
 {
-	const bool bIsEngineContent = Object->GetPathName().StartsWith("/Engine/");
-	const bool bIsProjectContent = Object->GetPathName().StartsWith("/Game/");
+	// Modify() is called before the change is made, so the index only notes the package and reads its GUIDs on the next lookup
+	if (Index.IsOpen() && FGuidFixerTrackedGuids::IsTracked(Object))
+	{
+		Index.MarkPackageDirty(Object->GetPackage());
+	}
+}
+
+void FGuidFixerModule::OnPackagePreSave(UPackage* Package, FObjectPreSaveContext ObjectSaveContext)
+{
+	if (GGuidFixerPreSaveCheck <= 0 || ObjectSaveContext.IsProceduralSave() || !Index.IsOpen())
+	{
+		return;
+	}
+
+	// Only the exports of this package are looked at, each with a constant number of index lookups
+	const FName PackageName = Package->GetFName();
+	PendingGuidFixes.Remove(PackageName);
+	TArray<FGuidFixerTrackedGuid> Guids;
+	TArray<FGuidFixerIndexOwner> Owners;
+	ForEachObjectWithPackage(Package, [this, PackageName, &Guids, &Owners](UObject* Object)
+	{
+		Guids.Reset();
+		FGuidFixerTrackedGuids::Get(Object, Guids);
+		for (const FGuidFixerTrackedGuid& Tracked : Guids)
+		{
+			Owners.Reset();
+			Index.Find(FGuidFixerTrackedGuids::ToEngine(Tracked.Guid), Owners);
+			const FGuidFixerIndexOwner* Conflict = Owners.FindByPredicate([PackageName, &Tracked](const FGuidFixerIndexOwner& Owner) { return Owner.PackageName != PackageName && Owner.Kind == Tracked.Kind; });
+			if (!Conflict)
+			{
+				continue;
+			}
+
+			UE_LOG(LogTemp, Warning, TEXT("%s: Saving with a %s GUID that collides with %s. Fix it with Tools -> GUID Fixer."), *Object->GetPathName(), *FGuidFixerTrackedGuids::KindToString(Tracked.Kind), *Conflict->PackageName.ToString());
+
+			// Changing objects that are being serialized would save them half modified and outside of the undo history,
+			// so the fix waits until the save is done
+			if (GGuidFixerPreSaveCheck >= 2 && ShouldModifyPath(Object->GetPathName()))
+			{
+				PendingGuidFixes.FindOrAdd(PackageName).Add({ Object, Tracked.Kind, Conflict->PackageName });
+			}
+		}
+		return true;
+	}, false);
+}
+
+void FGuidFixerModule::OnCookFinished(UCookOnTheFlyServer& CookOnTheFlyServer)
+{
+	// The editor can cook more than once in a session, each report only covers its own cook
+	if (CookMonitor->GetNumCookedPackages() > 0)
+	{
+		CookMonitor->WriteReport();
+		CookMonitor->Reset();
+	}
+}
+
+void FGuidFixerModule::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	if (ObjectSaveContext.IsCooking())
+	{
+		CookMonitor->OnPackageCooked(Package);
+		return;
+	}
+
+	if (ObjectSaveContext.IsProceduralSave())
+	{
+		return;
+	}
+
+	Index.CommitPackage(Package);
+
+	TArray<FPendingGuidFix> GuidFixes;
+	if (PendingGuidFixes.RemoveAndCopyValue(Package->GetFName(), GuidFixes))
+	{
+		SavedGuidFixes.Append(MoveTemp(GuidFixes));
+		if (!FixSavedGuidsHandle.IsValid())
+		{
+			FixSavedGuidsHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGuidFixerModule::FixSavedGuids));
+		}
+	}
+}
+
+bool FGuidFixerModule::FixSavedGuids(float DeltaTime)
+{
+	FixSavedGuidsHandle.Reset();
+
+	for (const FPendingGuidFix& GuidFix : SavedGuidFixes)
+	{
+		UObject* Object = GuidFix.Object.Get();
+		if (!Object)
+		{
+			continue;
+		}
+
+		Object->Modify();
+		if (FGuidFixerTrackedGuids::Regenerate(Object, GuidFix.Kind))
+		{
+			UE_LOG(LogTemp, Display, TEXT("%s: %s GUID collided with %s and has been regenerated after saving, save it again to keep the new GUID."), *Object->GetPathName(), *FGuidFixerTrackedGuids::KindToString(GuidFix.Kind), *GuidFix.CollidingPackage.ToString());
+		}
+	}
+	SavedGuidFixes.Reset();
+
+	// Runs once per batch of saves
+	return false;
+}
+
+bool FGuidFixerModule::ShouldModifyPath(const FString& PathName) const
+{
+	const bool bIsEngineContent = PathName.StartsWith("/Engine/");
+	const bool bIsProjectContent = PathName.StartsWith("/Game/");
 	const bool bIsPluginContent = !bIsEngineContent && !bIsProjectContent;
 
 	return bIsProjectContent;
 }
 
-// This function is a modified version of laggyluk's SwarmGuidFixer
-// https://github.com/laggyluk/SwarmGuidFixer
-void FGuidFixerModule::FixMaterialGuids() const
+template<typename T>
+bool FGuidFixerModule::ShouldModify(T* Object) const
 {
-	TMap<FGuid, UMaterialInterface*> Guids;
+	return ShouldModifyPath(Object->GetPathName());
+}
 
-	bool bMadeChanges = false;
-	bool bHasWarnings = false;
-	for (TObjectIterator<UMaterialInterface> Material; Material; ++Material)
+template<typename T>
+bool FGuidFixerModule::CanModify(T* Object, const TSet<FName>& UneditablePackages) const
+{
+	return ShouldModify(Object) && !UneditablePackages.Contains(Object->GetPackage()->GetFName());
+}
+
+/**
+ * Hashes the source bulk data of a texture as it is stored, which covers every block, layer and mip without decoding any of them.
+ * Sources stored with different compression hash differently even if their pixels match. @return a zero hash if there is no data
+ */
+static FBlake3Hash HashTextureSourceBulkData(UTexture* Texture)
+{
+	FBlake3Hash Hash;
+	Texture->Source.OperateOnLoadedBulkData([&Hash](const FSharedBuffer& BulkData)
 	{
-		if (!Material->GetLightingGuid().IsValid())
+		if (BulkData.GetSize() > 0)
 		{
-			if (ShouldModify(*Material))
-			{
-				Material->SetLightingGuid();
-				Material->Modify();
-				bMadeChanges = true;
-				UE_LOG(LogTemp, Display, TEXT("%s: Material has had its GUID updated."), *Material->GetPathName());
-			}
-			else
+			Hash = FBlake3::HashBuffer(BulkData.GetData(), BulkData.GetSize());
+		}
+	});
+	return Hash;
+}
+
+void FGuidFixerModule::ExcludeSharedContent(FGuidFixerResolution& Resolution, const std::vector<FGuidFixerScanRecord>& Records, TFunctionRef<UObject*(uint32)> GetObject) const
+{
+	const auto IsSharedByContent = [](const FGuidFixerCollisionGroup& Group)
+	{
+		return !FGuidFixerTrackedGuids::MustBeUnique(Group.Kind);
+	};
+
+	// Only records that collide are hashed, so the source of the vast majority of textures is never read
+	const bool bCanReadPayloads = FGuidFixerPayloadGuard::CanReadPayloads();
+	TArray<uint32> ToHash;
+	// Groups are identified by their first record, a record is in one group at most
+	TSet<uint32> Unreadable;
+	for (const FGuidFixerCollisionGroup& Group : Resolution.Collisions)
+	{
+		if (!IsSharedByContent(Group))
+		{
+			continue;
+		}
+		const bool bCanRead = std::all_of(Group.Records.begin(), Group.Records.end(), [&GetObject, bCanReadPayloads](uint32 Record)
+		{
+			const UTexture* const Texture = Cast<UTexture>(GetObject(Record));
+			return Texture && (bCanReadPayloads || Texture->Source.IsBulkDataLoaded());
+		});
+		if (bCanRead)
+		{
+			ToHash.Append(Group.Records.data(), Group.Records.size());
+		}
+		else
+		{
+			Unreadable.Add(Group.Records[0]);
+		}
+	}
+
+	if (ToHash.Num() == 0 && Unreadable.Num() == 0)
+	{
+		return;
+	}
+
+	// The whole source is compared, textures that only differ past their first block, layer or mip are not identical
+	TArray<FBlake3Hash> Hashes;
+	Hashes.SetNum(ToHash.Num());
+	ParallelFor(ToHash.Num(), [&ToHash, &Hashes, &GetObject](int32 Index)
+	{
+		Hashes[Index] = HashTextureSourceBulkData(CastChecked<UTexture>(GetObject(ToHash[Index])));
+	});
+
+	TMap<uint32, FBlake3Hash> RecordHashes;
+	for (int32 Index = 0; Index < ToHash.Num(); ++Index)
+	{
+		RecordHashes.Add(ToHash[Index], Hashes[Index]);
+	}
+
+	// A shared ID is only a conflict if the content behind it differs, groups that can't be compared are left alone
+	TSet<uint32> Excluded;
+	const auto Last = std::remove_if(Resolution.Collisions.begin(), Resolution.Collisions.end(), [&](const FGuidFixerCollisionGroup& Group)
+	{
+		if (!IsSharedByContent(Group))
+		{
+			return false;
+		}
+
+		UObject* const First = GetObject(Group.Records[0]);
+		const int32 NumOthers = int32(Group.Records.size()) - 1;
+		const bool bHashed = !Unreadable.Contains(Group.Records[0]) && std::none_of(Group.Records.begin(), Group.Records.end(), [&RecordHashes](uint32 Record) { return RecordHashes.FindChecked(Record).IsZero(); });
+		if (!bHashed)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: Shares its source ID with %d other texture(s), but their source data couldn't be read to compare. The source ID is left unchanged."), *First->GetPathName(), NumOthers);
+		}
+		else
+		{
+			const FBlake3Hash& FirstHash = RecordHashes.FindChecked(Group.Records[0]);
+			if (std::any_of(Group.Records.begin(), Group.Records.end(), [&RecordHashes, &FirstHash](uint32 Record) { return RecordHashes.FindChecked(Record) != FirstHash; }))
 			{
-				bHasWarnings = true;
-				UE_LOG(LogTemp, Warning, TEXT("%s: Material has invalid GUID but is specified not to be modified. @see FGuidFixerModule::ShouldModify()"), *Material->GetPathName());
-				continue;
+				return false;
 			}
+			UE_LOG(LogTemp, Display, TEXT("%s: Shares its source ID with %d other texture(s) with identical source data, which is not a conflict."), *First->GetPathName(), NumOthers);
 		}
 
-		const FGuid CacheCurrentGuid = Material->GetLightingGuid();
-		UMaterialInterface** Result = Guids.Find(CacheCurrentGuid);
-		if (Result)
+		Excluded.Append(Group.Records.data(), Group.Records.size());
+		return true;
+	});
+	Resolution.Collisions.erase(Last, Resolution.Collisions.end());
+
+	Resolution.ToRegenerate.erase(std::remove_if(Resolution.ToRegenerate.begin(), Resolution.ToRegenerate.end(), [&Excluded](uint32 Record) { return Excluded.Contains(Record); }), Resolution.ToRegenerate.end());
+}
+
+template<typename T>
+FGuidFixerResolution FGuidFixerModule::ResolveGuids(const FGuidFixerResolveOptions& Options, const TSet<FName>& UneditablePackages, TArray<T*>& OutObjects, std::vector<FGuidFixerScanRecord>& OutRecords) const
+{
+	FGuidFixerLoadedObjectSource Source(T::StaticClass(), [this, &UneditablePackages](const UObject* Object) { return CanModify(Object, UneditablePackages); });
+	Source.ReadAll(OutRecords);
+
+	OutObjects.Reserve(OutRecords.size());
+	for (const FGuidFixerScanRecord& Record : OutRecords)
+	{
+		OutObjects.Add(CastChecked<T>(Source.GetObject(Record.Identity)));
+	}
+
+	FGuidFixerResolution Resolution = FGuidFixerCollisionDetector::Resolve(OutRecords, Options);
+	ExcludeSharedContent(Resolution, OutRecords, [&OutObjects](uint32 Record) -> UObject* { return OutObjects[Record]; });
+	return Resolution;
+}
+
+template<typename T>
+bool FGuidFixerModule::ApplyResolution(const FGuidFixerResolution& Resolution, const TArray<T*>& Objects, const std::vector<FGuidFixerScanRecord>& Records, const FGuidFixerResolveOptions& Options, const TSet<FName>& UneditablePackages, const TCHAR* ObjectType, TSet<FName>& OutModifiedPackages) const
+{
+	bool bHasWarnings = false;
+	for (const uint32 Record : Resolution.InvalidRecords)
+	{
+		if (!Options.bFixInvalid)
+		{
+			// Only the texture fixer leaves invalid GUIDs to a command of their own
+			bHasWarnings = true;
+			UE_LOG(LogTemp, Warning, TEXT("%s: %s has invalid GUID but is not modified. Fix this by running Tools -> GUID Fixer -> Fix Empty Texture Guids"), *Objects[Record]->GetPathName(), ObjectType);
+		}
+		else if (!CanModify(Objects[Record], UneditablePackages))
 		{
-			UMaterialInterface* ResultRef = (*Result);
+			bHasWarnings = true;
+			UE_LOG(LogTemp, Warning, TEXT("%s: %s has invalid GUID but is specified not to be modified or could not be checked out. @see FGuidFixerModule::ShouldModify()"), *Objects[Record]->GetPathName(), ObjectType);
+		}
+	}
 
-			bool bAnyGuidsModified = false;
+	for (const FGuidFixerCollisionGroup& Group : Resolution.Collisions)
+	{
+		TArray<const UObject*> GroupObjects;
+		for (const uint32 Record : Group.Records)
+		{
+			GroupObjects.AddUnique(Objects[Record]);
+		}
+		LogImportLineage(GroupObjects);
 
-			// Update the initial material with the same GUID if its GUID hasn't been updated already
-			// This is probably unnecessary, but better safe than sorry
-			if (ResultRef->GetLightingGuid() == Material->GetLightingGuid())
+		if (!Group.bResolvable)
+		{
+			// Every record after the first unmodifiable one still collides with it
+			T* FirstFixed = nullptr;
+			for (const uint32 Record : Group.Records)
 			{
-				if (ShouldModify(ResultRef))
+				if (CanModify(Objects[Record], UneditablePackages))
+				{
+					continue;
+				}
+				if (FirstFixed)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("%s: %s has conflicting GUID with %s but both are specified not to be modified or could not be checked out. @see FGuidFixerModule::ShouldModify()"), *Objects[Record]->GetPathName(), ObjectType, *FirstFixed->GetPathName());
+				}
+				else
 				{
-					ResultRef->SetLightingGuid();
-					ResultRef->Modify();
-					bAnyGuidsModified = true;
-					Guids.Remove(CacheCurrentGuid);
-					Guids.Add(ResultRef->GetLightingGuid(), ResultRef);
-					UE_LOG(LogTemp, Display, TEXT("%s: Material has had its GUID updated."), *ResultRef->GetPathName());
+					FirstFixed = Objects[Record];
 				}
 			}
+			bHasWarnings = true;
+		}
+	}
+
+	for (const uint32 Record : Resolution.ToRegenerate)
+	{
+		T* const Object = Objects[Record];
+		FGuidFixerTrackedGuids::Regenerate(Object, Records[Record].Kind);
+		Object->Modify();
+		OutModifiedPackages.Add(Object->GetPackage()->GetFName());
+		UE_LOG(LogTemp, Display, TEXT("%s: %s has had its GUID updated."), *Object->GetPathName(), ObjectType);
+	}
 
-			if (ShouldModify(*Material))
+	return bHasWarnings;
+}
+
+template<typename T>
+TSet<FName> FGuidFixerModule::FindPackagesToModify(const FGuidFixerResolveOptions& Options) const
+{
+	// Dry run of the fixers below, so the impact can be estimated before anything is touched
+	TArray<T*> Objects;
+	std::vector<FGuidFixerScanRecord> Records;
+	const FGuidFixerResolution Resolution = ResolveGuids(Options, TSet<FName>(), Objects, Records);
+
+	TSet<FName> PackageNames;
+	for (const uint32 Record : Resolution.ToRegenerate)
+	{
+		PackageNames.Add(Objects[Record]->GetPackage()->GetFName());
+	}
+	return PackageNames;
+}
+
+bool FGuidFixerModule::ConfirmImpact(const TSet<FName>& PackageNames, bool bAffectsLighting, bool bAffectsStreaming, FGuidFixerImpact& OutImpact, const FString& Details) const
+{
+	if (PackageNames.Num() == 0)
+	{
+		return true;
+	}
+
+	OutImpact = FGuidFixerImpact::Estimate(PackageNames, bAffectsLighting, bAffectsStreaming);
+	UE_LOG(LogTemp, Display, TEXT("Estimated impact of changing %d package(s): %s"), PackageNames.Num(), *OutImpact.ToString());
+
+	if (OutImpact.IsEmpty() && Details.IsEmpty())
+	{
+		return true;
+	}
+
+	FString Message = FString::Printf(TEXT("%d asset(s) will have their GUID changed.\n%s"), PackageNames.Num(), *OutImpact.ToString());
+	if (!Details.IsEmpty())
+	{
+		Message += TEXT("\n\n") + Details;
+	}
+	const FText DialogText = FText::FromString(Message + TEXT("\n\nDo you want to continue?"));
+	return FMessageDialog::Open(EAppMsgType::YesNo, DialogText) == EAppReturnType::Yes;
+}
+
+void FGuidFixerModule::RebuildActualImpact(const FGuidFixerImpact& EstimatedImpact, const TSet<FName>& ModifiedPackages, bool bAffectsLighting, bool bAffectsStreaming, double StartTime) const
+{
+	if (ModifiedPackages.Num() == 0)
+	{
+		return;
+	}
+
+	const double FixSeconds = FPlatformTime::Seconds() - StartTime;
+	const FGuidFixerImpact ActualImpact = FGuidFixerImpact::Estimate(ModifiedPackages, bAffectsLighting, bAffectsStreaming);
+
+	// The GUIDs are cheap to change, what the change costs in the editor is the work on the levels depending on them
+	double RebuildStartTime = FPlatformTime::Seconds();
+	const int32 NumInvalidatedLevels = ActualImpact.InvalidateLighting();
+	const double LightingSeconds = FPlatformTime::Seconds() - RebuildStartTime;
+
+	RebuildStartTime = FPlatformTime::Seconds();
+	const int32 NumRebuiltLevels = ActualImpact.RebuildTextureStreaming();
+	const double StreamingSeconds = FPlatformTime::Seconds() - RebuildStartTime;
+
+	UE_LOG(LogTemp, Display, TEXT("Changed %d package(s) in %.2fs: %s (estimated %d lighting, %d streaming, %d material)"),
+		ModifiedPackages.Num(), FixSeconds, *ActualImpact.ToString(),
+		EstimatedImpact.LightingLevels.Num(), EstimatedImpact.StreamingLevels.Num(), EstimatedImpact.DependentMaterials.Num());
+	UE_LOG(LogTemp, Display, TEXT("Invalidated lighting of %d loaded level(s) in %.2fs and rebuilt texture streaming of %d loaded level(s) in %.2fs, %.2fs in total."),
+		NumInvalidatedLevels, LightingSeconds, NumRebuiltLevels, StreamingSeconds, FPlatformTime::Seconds() - StartTime);
+}
+
+static TOptional<FAssetImportInfo> GetImportInfo(const UObject* Object)
+{
+	// Read the cached registry tags rather than the import data on the object, so this also works for objects that are only partially loaded
+	const FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(FName(*Object->GetPathName()), true);
+	FString ImportDataJson;
+	if (!AssetData.IsValid() || !AssetData.GetTagValue(UObject::SourceFileTagName(), ImportDataJson))
+	{
+		return TOptional<FAssetImportInfo>();
+	}
+
+	TOptional<FAssetImportInfo> ImportInfo = UAssetImportData::FromJson(ImportDataJson);
+	if (ImportInfo.IsSet() && ImportInfo->SourceFiles.Num() == 0)
+	{
+		return TOptional<FAssetImportInfo>();
+	}
+	return ImportInfo;
+}
+
+void FGuidFixerModule::LogImportLineage(const TArray<const UObject*>& Objects) const
+{
+	TArray<TOptional<FAssetImportInfo>> ImportInfos;
+	ImportInfos.Reserve(Objects.Num());
+	for (const UObject* Object : Objects)
+	{
+		ImportInfos.Add(GetImportInfo(Object));
+		if (!ImportInfos.Last().IsSet())
+		{
+			UE_LOG(LogTemp, Display, TEXT("%s: Has no import data, it was likely created or duplicated in the editor."), *Object->GetPathName());
+			continue;
+		}
+
+		// Only the first source file is compared, multi-source assets are rare and share the lineage of their primary file
+		const FAssetImportInfo::FSourceFile& SourceFile = ImportInfos.Last()->SourceFiles[0];
+		UE_LOG(LogTemp, Display, TEXT("%s: Imported from %s (MD5 %s, %s)."), *Object->GetPathName(), *SourceFile.RelativeFilename, *LexToString(SourceFile.FileHash), *SourceFile.Timestamp.ToString());
+	}
+
+	// Each unordered pair is compared once
+	for (int32 Index = 1; Index < Objects.Num(); ++Index)
+	{
+		for (int32 OtherIndex = 0; OtherIndex < Index; ++OtherIndex)
+		{
+			if (!ImportInfos[Index].IsSet() || !ImportInfos[OtherIndex].IsSet())
 			{
-				Material->SetLightingGuid();
-				Material->Modify();
-				bMadeChanges = true;
-				bAnyGuidsModified = true;
-				Guids.Add(Material->GetLightingGuid(), *Material);
-				UE_LOG(LogTemp, Display, TEXT("%s: Material has had its GUID updated."), *Material->GetPathName());
+				continue;
 			}
 
-			if (!bAnyGuidsModified)
+			const FAssetImportInfo::FSourceFile& SourceFile = ImportInfos[Index]->SourceFiles[0];
+			const FAssetImportInfo::FSourceFile& ConflictingSourceFile = ImportInfos[OtherIndex]->SourceFiles[0];
+			const FString PathName = Objects[Index]->GetPathName();
+			const FString ConflictingPathName = Objects[OtherIndex]->GetPathName();
+			const bool bSameFile = SourceFile.RelativeFilename == ConflictingSourceFile.RelativeFilename;
+			const bool bSameHash = SourceFile.FileHash == ConflictingSourceFile.FileHash;
+			if (bSameFile && bSameHash && SourceFile.Timestamp == ConflictingSourceFile.Timestamp)
 			{
-				bHasWarnings = true;
-				UE_LOG(LogTemp, Warning, TEXT("%s: Material has conflicting GUID with %s but both are specified not to be modified. @see FGuidFixerModule::ShouldModify()"), *Material->GetPathName(), *ResultRef->GetPathName());
+				UE_LOG(LogTemp, Display, TEXT("%s: Import data matches %s exactly, it was likely duplicated in the editor."), *PathName, *ConflictingPathName);
+			}
+			else if (bSameHash)
+			{
+				UE_LOG(LogTemp, Display, TEXT("%s: Imported from the same source content as %s, it was likely imported twice."), *PathName, *ConflictingPathName);
+			}
+			else if (bSameFile)
+			{
+				UE_LOG(LogTemp, Display, TEXT("%s: Imported from the same source file as %s after the file changed."), *PathName, *ConflictingPathName);
 			}
+		}
+	}
+}
 
+int32 FGuidFixerModule::FindDuplicateTextureSources() const
+{
+	// Bucket by the source description first, only textures that share one can possibly have identical data
+	// This keeps us from reading bulk data for the vast majority of textures
+	// Payloads that aren't resident could be pulled from a virtualization backend when read, so those textures are skipped
+	const bool bCanReadPayloads = FGuidFixerPayloadGuard::CanReadPayloads();
+	int32 NumSkipped = 0;
+
+	TMap<FString, TArray<UTexture*>> Candidates;
+	for (TObjectIterator<UTexture> Texture; Texture; ++Texture)
+	{
+		const FTextureSource& Source = Texture->Source;
+		if (!Source.IsValid())
+		{
+			continue;
+		}
+
+		if (!bCanReadPayloads && !Source.IsBulkDataLoaded())
+		{
+			++NumSkipped;
 			continue;
 		}
 
-		Guids.Add(Material->GetLightingGuid(), *Material);
+		FString Key = FString::Printf(TEXT("%dx%dx%d_%d_%d_%d"), Source.GetSizeX(), Source.GetSizeY(), Source.GetNumSlices(),
+			Source.GetNumMips(), Source.GetNumBlocks(), Source.GetNumLayers());
+		for (int32 LayerIndex = 0; LayerIndex < Source.GetNumLayers(); ++LayerIndex)
+		{
+			Key += FString::Printf(TEXT("_%d"), static_cast<int32>(Source.GetFormat(LayerIndex)));
+		}
+		Candidates.FindOrAdd(Key).Add(*Texture);
+	}
+
+	TArray<UTexture*> ToHash;
+	for (const TPair<FString, TArray<UTexture*>>& Candidate : Candidates)
+	{
+		if (Candidate.Value.Num() > 1)
+		{
+			ToHash.Append(Candidate.Value);
+		}
+	}
+
+	TArray<FBlake3Hash> Hashes;
+	Hashes.SetNum(ToHash.Num());
+	ParallelFor(ToHash.Num(), [&ToHash, &Hashes](int32 Index)
+	{
+		Hashes[Index] = HashTextureSourceBulkData(ToHash[Index]);
+	});
+
+	if (NumSkipped > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("%d texture(s) were not checked for duplicate sources, their source data isn't loaded and reading it could pull virtualized payloads."), NumSkipped);
 	}
 
+	TMap<FBlake3Hash, TArray<UTexture*>> Duplicates;
+	for (int32 Index = 0; Index < ToHash.Num(); ++Index)
+	{
+		if (!Hashes[Index].IsZero())
+		{
+			Duplicates.FindOrAdd(Hashes[Index]).Add(ToHash[Index]);
+		}
+	}
+
+	int32 NumDuplicateGroups = 0;
+	for (const TPair<FBlake3Hash, TArray<UTexture*>>& Duplicate : Duplicates)
+	{
+		if (Duplicate.Value.Num() < 2)
+		{
+			continue;
+		}
+
+		++NumDuplicateGroups;
+		for (int32 Index = 1; Index < Duplicate.Value.Num(); ++Index)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: Texture has identical source data to %s and is a candidate for merging."), *Duplicate.Value[Index]->GetPathName(), *Duplicate.Value[0]->GetPathName());
+		}
+	}
+
+	return NumDuplicateGroups;
+}
+
+// This function is a modified version of laggyluk's SwarmGuidFixer
+// https://github.com/laggyluk/SwarmGuidFixer
+void FGuidFixerModule::FixMaterialGuids() const
+{
+	FGuidFixerPayloadGuard PayloadGuard(TEXT("FixMaterialGuids"));
+
+	FGuidFixerResolveOptions Options;
+	Options.bFixInvalid = true;
+	Options.bFixDuplicates = true;
+
+	FGuidFixerImpact EstimatedImpact;
+	const TSet<FName> PackagesToModify = FindPackagesToModify<UMaterialInterface>(Options);
+	if (!ConfirmImpact(PackagesToModify, true, false, EstimatedImpact))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const TSet<FName> UneditablePackages = FGuidFixerSourceControl::CheckOutPackages(PackagesToModify);
+	TSet<FName> ModifiedPackages;
+	TArray<UMaterialInterface*> Materials;
+	std::vector<FGuidFixerScanRecord> Records;
+	const FGuidFixerResolution Resolution = ResolveGuids(Options, UneditablePackages, Materials, Records);
+	const bool bMadeChanges = !Resolution.ToRegenerate.empty();
+	const bool bHasWarnings = ApplyResolution(Resolution, Materials, Records, Options, UneditablePackages, TEXT("Material"), ModifiedPackages);
+
+	RebuildActualImpact(EstimatedImpact, ModifiedPackages, true, false, StartTime);
+
 	FText DialogText = FText::FromString("No duplicate material GUIDs found.");
 	if (bMadeChanges && bHasWarnings)
 		DialogText = FText::FromString("At least one material GUID has been changed, but there are some unresolvable issues (Please refer to log). Use save all to save these changes.");
@@ -167,106 +756,478 @@ void FGuidFixerModule::FixMaterialGuids() const
 
 void FGuidFixerModule::FixTextureGuids() const
 {
-	TMap<FGuid, UTexture*> Guids;
+	FGuidFixerPayloadGuard PayloadGuard(TEXT("FixTextureGuids"));
 
-	bool bMadeChanges = false;
-	bool bHasWarnings = false;
-	for (TObjectIterator<UTexture> Texture; Texture; ++Texture)
+	FGuidFixerResolveOptions Options;
+	Options.bFixInvalid = false;
+	Options.bFixDuplicates = true;
+
+	FGuidFixerImpact EstimatedImpact;
+	const TSet<FName> PackagesToModify = FindPackagesToModify<UTexture>(Options);
+	if (!ConfirmImpact(PackagesToModify, true, true, EstimatedImpact))
 	{
-		if (!Texture->GetLightingGuid().IsValid())
-		{
-			bHasWarnings = true;
-			UE_LOG(LogTemp, Warning, TEXT("%s: Texture has invalid GUID but is not modified. Fix this by running Tools -> GUID Fixer -> Fix Empty Texture Guids"), *Texture->GetPathName());
-			continue;
-		}
+		return;
+	}
 
-		const FGuid CacheCurrentGuid = Texture->GetLightingGuid();
-		UTexture** Result = Guids.Find(CacheCurrentGuid);
-		if (Result)
-		{
-			UTexture* ResultRef = (*Result);
+	const double StartTime = FPlatformTime::Seconds();
+	const TSet<FName> UneditablePackages = FGuidFixerSourceControl::CheckOutPackages(PackagesToModify);
+	TSet<FName> ModifiedPackages;
+	TArray<UTexture*> Textures;
+	std::vector<FGuidFixerScanRecord> Records;
+	const FGuidFixerResolution Resolution = ResolveGuids(Options, UneditablePackages, Textures, Records);
+	const bool bMadeChanges = !Resolution.ToRegenerate.empty();
+	const bool bHasWarnings = ApplyResolution(Resolution, Textures, Records, Options, UneditablePackages, TEXT("Texture"), ModifiedPackages);
 
-			bool bAnyGuidsModified = false;
+	RebuildActualImpact(EstimatedImpact, ModifiedPackages, true, true, StartTime);
 
-			// Update the initial texture with the same GUID if its GUID hasn't been updated already
-			// This is probably unnecessary, but better safe than sorry
-			if (ResultRef->GetLightingGuid() == Texture->GetLightingGuid())
+	const int32 NumDuplicateSources = FindDuplicateTextureSources();
+
+	FText DialogText = FText::FromString("No duplicate texture GUIDs found.");
+	if (bMadeChanges && bHasWarnings)
+		DialogText = FText::FromString("At least one texture GUID has been changed, but there are some unresolvable issues (Please refer to log). Use save all to save these changes.");
+	else if (bMadeChanges)
+		DialogText = FText::FromString("At least one texture GUID has been changed. Use save all to save these changes.");
+	else if (bHasWarnings)
+		DialogText = FText::FromString("No texture GUID has been changed, but there are some unresolvable issues (Please refer to log).");
+	if (NumDuplicateSources > 0)
+		DialogText = FText::FromString(FString::Printf(TEXT("%s\n\n%d group(s) of textures have identical source data and could be merged (Please refer to log)."), *DialogText.ToString(), NumDuplicateSources));
+	FMessageDialog::Open(EAppMsgType::Ok, DialogText);
+}
+
+void FGuidFixerModule::FixEmptyTextureGuids() const
+{
+	FGuidFixerPayloadGuard PayloadGuard(TEXT("FixEmptyTextureGuids"));
+
+	FGuidFixerResolveOptions Options;
+	Options.bFixInvalid = true;
+	Options.bFixDuplicates = false;
+
+	FGuidFixerImpact EstimatedImpact;
+	const TSet<FName> PackagesToModify = FindPackagesToModify<UTexture>(Options);
+	if (!ConfirmImpact(PackagesToModify, true, true, EstimatedImpact))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const TSet<FName> UneditablePackages = FGuidFixerSourceControl::CheckOutPackages(PackagesToModify);
+	TSet<FName> ModifiedPackages;
+	TArray<UTexture*> Textures;
+	std::vector<FGuidFixerScanRecord> Records;
+	const FGuidFixerResolution Resolution = ResolveGuids(Options, UneditablePackages, Textures, Records);
+	const bool bMadeChanges = !Resolution.ToRegenerate.empty();
+	const bool bHasWarnings = ApplyResolution(Resolution, Textures, Records, Options, UneditablePackages, TEXT("Texture"), ModifiedPackages);
+
+	RebuildActualImpact(EstimatedImpact, ModifiedPackages, true, true, StartTime);
+
+	FText DialogText = FText::FromString("No empty texture GUIDs found.");
+	if (bMadeChanges && bHasWarnings)
+		DialogText = FText::FromString("At least one texture GUID has been changed, but there are some unresolvable issues (Please refer to log). Use save all to save these changes.");
+	else if (bMadeChanges)
+		DialogText = FText::FromString("At least one texture GUID has been changed. Use save all to save these changes.");
+	else if (bHasWarnings)
+		DialogText = FText::FromString("No texture GUID has been changed, but there are some unresolvable issues (Please refer to log).");
+	FMessageDialog::Open(EAppMsgType::Ok, DialogText);
+}
+
+void FGuidFixerModule::FixSoundWaveGuids() const
+{
+	FGuidFixerPayloadGuard PayloadGuard(TEXT("FixSoundWaveGuids"));
+
+	FGuidFixerResolveOptions Options;
+	Options.bFixInvalid = true;
+	Options.bFixDuplicates = true;
+
+	// Compressed audio isn't referenced by lighting or streaming data, the cook just recompresses the changed sounds
+	FGuidFixerImpact EstimatedImpact;
+	const TSet<FName> PackagesToModify = FindPackagesToModify<USoundWave>(Options);
+	if (!ConfirmImpact(PackagesToModify, false, false, EstimatedImpact))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const TSet<FName> UneditablePackages = FGuidFixerSourceControl::CheckOutPackages(PackagesToModify);
+	TSet<FName> ModifiedPackages;
+	TArray<USoundWave*> SoundWaves;
+	std::vector<FGuidFixerScanRecord> Records;
+	const FGuidFixerResolution Resolution = ResolveGuids(Options, UneditablePackages, SoundWaves, Records);
+	const bool bMadeChanges = !Resolution.ToRegenerate.empty();
+	const bool bHasWarnings = ApplyResolution(Resolution, SoundWaves, Records, Options, UneditablePackages, TEXT("Sound wave"), ModifiedPackages);
+
+	RebuildActualImpact(EstimatedImpact, ModifiedPackages, false, false, StartTime);
+
+	FText DialogText = FText::FromString("No duplicate sound wave GUIDs found.");
+	if (bMadeChanges && bHasWarnings)
+		DialogText = FText::FromString("At least one sound wave GUID has been changed, but there are some unresolvable issues (Please refer to log). Use save all to save these changes.");
+	else if (bMadeChanges)
+		DialogText = FText::FromString("At least one sound wave GUID has been changed. Use save all to save these changes.");
+	else if (bHasWarnings)
+		DialogText = FText::FromString("No sound wave GUID has been changed, but there are some unresolvable issues (Please refer to log).");
+	FMessageDialog::Open(EAppMsgType::Ok, DialogText);
+}
+
+void FGuidFixerModule::FixStaticMeshGuids() const
+{
+	FGuidFixerPayloadGuard PayloadGuard(TEXT("FixStaticMeshGuids"));
+
+	FGuidFixerResolveOptions Options;
+	Options.bFixInvalid = false;
+	Options.bFixDuplicates = true;
+
+	// Only the meshes' own derived data is keyed by these IDs, it is rebuilt the next time each mesh is built
+	FGuidFixerImpact EstimatedImpact;
+	const TSet<FName> PackagesToModify = FindPackagesToModify<UStaticMesh>(Options);
+	if (!ConfirmImpact(PackagesToModify, false, false, EstimatedImpact))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const TSet<FName> UneditablePackages = FGuidFixerSourceControl::CheckOutPackages(PackagesToModify);
+	TSet<FName> ModifiedPackages;
+	TArray<UStaticMesh*> StaticMeshes;
+	std::vector<FGuidFixerScanRecord> Records;
+	const FGuidFixerResolution Resolution = ResolveGuids(Options, UneditablePackages, StaticMeshes, Records);
+	const bool bMadeChanges = !Resolution.ToRegenerate.empty();
+	const bool bHasWarnings = ApplyResolution(Resolution, StaticMeshes, Records, Options, UneditablePackages, TEXT("Static mesh"), ModifiedPackages);
+
+	RebuildActualImpact(EstimatedImpact, ModifiedPackages, false, false, StartTime);
+
+	FText DialogText = FText::FromString("No duplicate static mesh GUIDs found.");
+	if (bMadeChanges && bHasWarnings)
+		DialogText = FText::FromString("At least one static mesh GUID has been changed, but there are some unresolvable issues (Please refer to log). Use save all to save these changes.");
+	else if (bMadeChanges)
+		DialogText = FText::FromString("At least one static mesh GUID has been changed. Use save all to save these changes.");
+	else if (bHasWarnings)
+		DialogText = FText::FromString("No static mesh GUID has been changed, but there are some unresolvable issues (Please refer to log).");
+	FMessageDialog::Open(EAppMsgType::Ok, DialogText);
+}
+
+void FGuidFixerModule::FixGraphNodeGuids() const
+{
+	// Node GUIDs only have to be unique within their graph, so every graph is resolved on its own
+	TArray<UObject*> Graphs;
+	GetObjectsOfClass(UEdGraph::StaticClass(), Graphs, true);
+
+	// Gathered on the game thread, the worker threads below only ever see the copied GUIDs
+	TArray<TArray<UEdGraphNode*>> GraphNodes;
+	TArray<std::vector<FGuidFixerScanRecord>> GraphRecords;
+	GraphNodes.SetNum(Graphs.Num());
+	GraphRecords.SetNum(Graphs.Num());
+	TSet<FGuid> SeenGuids;
+	for (int32 GraphIndex = 0; GraphIndex < Graphs.Num(); ++GraphIndex)
+	{
+		const UEdGraph* Graph = CastChecked<UEdGraph>(Graphs[GraphIndex]);
+		const bool bModifiable = ShouldModify(Graph);
+		SeenGuids.Reset();
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node)
 			{
-				if (ShouldModify(ResultRef))
-				{
-					ResultRef->SetLightingGuid();
-					ResultRef->Modify();
-					bAnyGuidsModified = true;
-					Guids.Remove(CacheCurrentGuid);
-					Guids.Add(ResultRef->GetLightingGuid(), ResultRef);
-					UE_LOG(LogTemp, Display, TEXT("%s: Texture has had its GUID updated."), *ResultRef->GetPathName());
-				}
+				continue;
 			}
 
-			if (ShouldModify(*Texture))
+			// The first node with a GUID keeps it, so breakpoints and diffs against older revisions still find the original
+			bool bAlreadySeen = false;
+			SeenGuids.Add(Node->NodeGuid, &bAlreadySeen);
+			const bool bIsCopy = bAlreadySeen || !Node->NodeGuid.IsValid();
+			GraphRecords[GraphIndex].push_back({ uint64_t(GraphNodes[GraphIndex].Num()), EGuidFixerGuidKind::GraphNode, FGuidFixerTrackedGuids::ToCore(Node->NodeGuid), bModifiable && bIsCopy });
+			GraphNodes[GraphIndex].Add(Node);
+		}
+	}
+
+	FGuidFixerResolveOptions Options;
+	Options.bFixInvalid = true;
+	Options.bFixDuplicates = true;
+
+	TArray<FGuidFixerResolution> Resolutions;
+	Resolutions.SetNum(Graphs.Num());
+	ParallelFor(Graphs.Num(), [&GraphRecords, &Resolutions, &Options](int32 GraphIndex)
+	{
+		Resolutions[GraphIndex] = FGuidFixerCollisionDetector::Resolve(GraphRecords[GraphIndex], Options);
+	});
+
+	TSet<FName> PackagesToModify;
+	for (int32 GraphIndex = 0; GraphIndex < Graphs.Num(); ++GraphIndex)
+	{
+		for (const uint32 Record : Resolutions[GraphIndex].ToRegenerate)
+		{
+			PackagesToModify.Add(GraphNodes[GraphIndex][Record]->GetPackage()->GetFName());
+		}
+	}
+
+	FGuidFixerImpact EstimatedImpact;
+	if (!ConfirmImpact(PackagesToModify, false, false, EstimatedImpact))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const TSet<FName> UneditablePackages = FGuidFixerSourceControl::CheckOutPackages(PackagesToModify);
+	TSet<FName> ModifiedPackages;
+	bool bHasWarnings = UneditablePackages.Num() > 0;
+	for (int32 GraphIndex = 0; GraphIndex < Graphs.Num(); ++GraphIndex)
+	{
+		const FGuidFixerResolution& Resolution = Resolutions[GraphIndex];
+		const TArray<UEdGraphNode*>& Nodes = GraphNodes[GraphIndex];
+		for (const FGuidFixerCollisionGroup& Group : Resolution.Collisions)
+		{
+			if (!Group.bResolvable)
 			{
-				Texture->SetLightingGuid();
-				Texture->Modify();
-				bMadeChanges = true;
-				bAnyGuidsModified = true;
-				Guids.Add(Texture->GetLightingGuid(), *Texture);
-				UE_LOG(LogTemp, Display, TEXT("%s: Texture has had its GUID updated."), *Texture->GetPathName());
+				bHasWarnings = true;
+				UE_LOG(LogTemp, Warning, TEXT("%s: %d nodes share GUID %s but the graph is specified not to be modified. @see FGuidFixerModule::ShouldModify()"),
+					*Graphs[GraphIndex]->GetPathName(), int32(Group.Records.size()), *FGuidFixerTrackedGuids::ToEngine(Group.Guid).ToString());
 			}
+		}
 
-			if (!bAnyGuidsModified)
+		// Only the node GUIDs change, so the Blueprints are left for the user to recompile when they next open them
+		for (const uint32 Record : Resolution.ToRegenerate)
+		{
+			UEdGraphNode* const Node = Nodes[Record];
+			const FName PackageName = Node->GetPackage()->GetFName();
+			if (UneditablePackages.Contains(PackageName))
 			{
-				bHasWarnings = true;
-				UE_LOG(LogTemp, Warning, TEXT("%s: Texture has conflicting GUID with %s but both are specified not to be modified. @see FGuidFixerModule::ShouldModify()"), *Texture->GetPathName(), *ResultRef->GetPathName());
+				continue;
 			}
 
-			continue;
+			Node->Modify();
+			Node->CreateNewGuid();
+			ModifiedPackages.Add(PackageName);
+			UE_LOG(LogTemp, Display, TEXT("%s: Graph node has had its GUID updated."), *Node->GetPathName());
 		}
-
-		Guids.Add(Texture->GetLightingGuid(), *Texture);
 	}
 
-	FText DialogText = FText::FromString("No duplicate texture GUIDs found.");
+	RebuildActualImpact(EstimatedImpact, ModifiedPackages, false, false, StartTime);
+
+	const bool bMadeChanges = ModifiedPackages.Num() > 0;
+	FText DialogText = FText::FromString("No duplicate graph node GUIDs found.");
 	if (bMadeChanges && bHasWarnings)
-		DialogText = FText::FromString("At least one texture GUID has been changed, but there are some unresolvable issues (Please refer to log). Use save all to save these changes.");
+		DialogText = FText::FromString("At least one graph node GUID has been changed, but there are some unresolvable issues (Please refer to log). Use save all to save these changes.");
 	else if (bMadeChanges)
-		DialogText = FText::FromString("At least one texture GUID has been changed. Use save all to save these changes.");
+		DialogText = FText::FromString("At least one graph node GUID has been changed. Use save all to save these changes.");
 	else if (bHasWarnings)
-		DialogText = FText::FromString("No texture GUID has been changed, but there are some unresolvable issues (Please refer to log).");
+		DialogText = FText::FromString("No graph node GUID has been changed, but there are some unresolvable issues (Please refer to log).");
 	FMessageDialog::Open(EAppMsgType::Ok, DialogText);
 }
 
-void FGuidFixerModule::FixEmptyTextureGuids() const
+void FGuidFixerModule::FixLevelBuildDataIds() const
 {
-	bool bMadeChanges = false;
-	bool bHasWarnings = false;
-	for (TObjectIterator<UTexture> Texture; Texture; ++Texture)
+	FGuidFixerPayloadGuard PayloadGuard(TEXT("FixLevelBuildDataIds"));
+
+	// Maps are compared from registry tags, only the copies that get a new ID are loaded
+	FGuidFixerAssetRegistryObjectSource Source([this](const FAssetData& Asset) { return ShouldModifyPath(Asset.ObjectPath.ToString()); }, UWorld::StaticClass());
+	std::vector<FGuidFixerScanRecord> Records;
+	Source.ReadAll(Records);
+
+	FGuidFixerResolveOptions Options;
+	Options.bFixInvalid = false;
+	Options.bFixDuplicates = true;
+	FGuidFixerResolution Resolution = FGuidFixerCollisionDetector::Resolve(Records, Options);
+
+	// Every modifiable map of a group would get a new ID, but one of them should keep the ID its build data is stored under.
+	// A map that must not be modified keeps it anyway. Otherwise a map whose own <Map>_BuiltData package is registered and
+	// among its dependencies does, as that is the map the stored build data was made for. When that leaves more than one map
+	// or none, the first package name in sort order does, which picks the same map on every machine and every run, unlike
+	// file times in a synced workspace.
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	const auto HasOwnBuildData = [&AssetRegistry](FName PackageName)
+	{
+		const FName BuiltDataPackageName(*(PackageName.ToString() + TEXT("_BuiltData")));
+		TArray<FAssetData> BuiltData;
+		if (!AssetRegistry.GetAssetsByPackageName(BuiltDataPackageName, BuiltData) || BuiltData.Num() == 0)
+		{
+			return false;
+		}
+
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+		return Dependencies.Contains(BuiltDataPackageName);
+	};
+	const auto IsFirstInSortOrder = [&Source, &Records](uint32 Lhs, uint32 Rhs)
+	{
+		return Source.GetAsset(Records[Lhs].Identity).PackageName.Compare(Source.GetAsset(Records[Rhs].Identity).PackageName) < 0;
+	};
+
+	TSet<uint32> Originals;
+	TArray<FString> Keepers;
+	for (const FGuidFixerCollisionGroup& Group : Resolution.Collisions)
 	{
-		if (Texture->GetLightingGuid().IsValid())
+		if (!std::all_of(Group.Records.begin(), Group.Records.end(), [&Records](uint32 Record) { return Records[Record].bModifiable; }))
 		{
 			continue;
 		}
-		
-		if (ShouldModify(*Texture))
+
+		TArray<uint32> Candidates;
+		for (const uint32 Record : Group.Records)
 		{
-			Texture->SetLightingGuid();
-			Texture->Modify();
-			bMadeChanges = true;
-			UE_LOG(LogTemp, Display, TEXT("%s: Texture has had its GUID updated."), *Texture->GetPathName());
+			if (HasOwnBuildData(Source.GetAsset(Records[Record].Identity).PackageName))
+			{
+				Candidates.Add(Record);
+			}
 		}
-		else
+		const bool bHasOwnBuildData = Candidates.Num() > 0;
+		if (!bHasOwnBuildData)
+		{
+			Candidates.Append(Group.Records.data(), Group.Records.size());
+		}
+
+		const uint32 Original = *std::min_element(Candidates.GetData(), Candidates.GetData() + Candidates.Num(), IsFirstInSortOrder);
+		Originals.Add(Original);
+		const FString PackageName = Source.GetAsset(Records[Original].Identity).PackageName.ToString();
+		const FString Guid = FGuidFixerTrackedGuids::ToEngine(Group.Guid).ToString();
+		const TCHAR* const Reason = bHasOwnBuildData ? TEXT("its own built data is stored under it") : TEXT("no map has its own built data, first in sort order");
+		UE_LOG(LogTemp, Display, TEXT("%s: Keeps build data ID %s shared by %d maps, %s."), *PackageName, *Guid, int32(Group.Records.size()), Reason);
+		Keepers.Add(FString::Printf(TEXT("%s keeps %s (%s)"), *PackageName, *Guid, Reason));
+	}
+	Resolution.ToRegenerate.erase(std::remove_if(Resolution.ToRegenerate.begin(), Resolution.ToRegenerate.end(), [&Originals](uint32 Record) { return Originals.Contains(Record); }), Resolution.ToRegenerate.end());
+
+	TSet<FName> PackagesToModify;
+	for (const uint32 Record : Resolution.ToRegenerate)
+	{
+		PackagesToModify.Add(Source.GetAsset(Records[Record].Identity).PackageName);
+	}
+
+	// Which map keeps the ID decides which build data stays valid, so it is shown before anything is changed
+	constexpr int32 MaxKeepersShown = 10;
+	FString KeeperDetails;
+	if (Keepers.Num() > 0)
+	{
+		KeeperDetails = TEXT("Maps keeping their build data ID:\n") + FString::Join(TArrayView<const FString>(Keepers.GetData(), FMath::Min(Keepers.Num(), MaxKeepersShown)), TEXT("\n"));
+		if (Keepers.Num() > MaxKeepersShown)
+		{
+			KeeperDetails += FString::Printf(TEXT("\n... and %d more (Please refer to log)"), Keepers.Num() - MaxKeepersShown);
+		}
+	}
+
+	FGuidFixerImpact EstimatedImpact;
+	if (!ConfirmImpact(PackagesToModify, true, false, EstimatedImpact, KeeperDetails))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const TSet<FName> UneditablePackages = FGuidFixerSourceControl::CheckOutPackages(PackagesToModify);
+	TSet<FName> ModifiedPackages;
+	bool bHasWarnings = UneditablePackages.Num() > 0;
+	for (const FGuidFixerCollisionGroup& Group : Resolution.Collisions)
+	{
+		if (!Group.bResolvable)
 		{
 			bHasWarnings = true;
-			UE_LOG(LogTemp, Warning, TEXT("%s: Texture has invalid GUID but is specified not to be modified. @see FGuidFixerModule::ShouldModify()"), *Texture->GetPathName());
+			UE_LOG(LogTemp, Warning, TEXT("%s: Map shares build data ID %s with other maps that are specified not to be modified. @see FGuidFixerModule::ShouldModify()"),
+				*Source.GetAsset(Records[Group.Records[0]].Identity).PackageName.ToString(), *FGuidFixerTrackedGuids::ToEngine(Group.Guid).ToString());
 		}
 	}
 
-	FText DialogText = FText::FromString("No empty texture GUIDs found.");
+	for (const uint32 Record : Resolution.ToRegenerate)
+	{
+		const FAssetData& Asset = Source.GetAsset(Records[Record].Identity);
+		if (UneditablePackages.Contains(Asset.PackageName))
+		{
+			continue;
+		}
+
+		UWorld* const World = Cast<UWorld>(Asset.GetAsset());
+		if (!World || !FGuidFixerTrackedGuids::Regenerate(World, EGuidFixerGuidKind::LevelBuildData))
+		{
+			bHasWarnings = true;
+			UE_LOG(LogTemp, Warning, TEXT("%s: Map could not be loaded to change its build data ID."), *Asset.PackageName.ToString());
+			continue;
+		}
+		ModifiedPackages.Add(Asset.PackageName);
+		UE_LOG(LogTemp, Display, TEXT("%s: Level has had its build data ID updated, its lighting needs to be rebuilt."), *Asset.PackageName.ToString());
+	}
+
+	RebuildActualImpact(EstimatedImpact, ModifiedPackages, true, false, StartTime);
+
+	const bool bMadeChanges = ModifiedPackages.Num() > 0;
+	FText DialogText = FText::FromString("No duplicate level build data IDs found.");
 	if (bMadeChanges && bHasWarnings)
-		DialogText = FText::FromString("At least one texture GUID has been changed, but there are some unresolvable issues (Please refer to log). Use save all to save these changes.");
+		DialogText = FText::FromString("At least one level build data ID has been changed, but there are some unresolvable issues (Please refer to log). Use save all to save these changes, then rebuild lighting for the changed levels.");
 	else if (bMadeChanges)
-		DialogText = FText::FromString("At least one texture GUID has been changed. Use save all to save these changes.");
+		DialogText = FText::FromString("At least one level build data ID has been changed. Use save all to save these changes, then rebuild lighting for the changed levels.");
 	else if (bHasWarnings)
-		DialogText = FText::FromString("No texture GUID has been changed, but there are some unresolvable issues (Please refer to log).");
+		DialogText = FText::FromString("No level build data ID has been changed, but there are some unresolvable issues (Please refer to log).");
+	FMessageDialog::Open(EAppMsgType::Ok, DialogText);
+}
+
+void FGuidFixerModule::FindAssetRegistryCollisions() const
+{
+	FGuidFixerPayloadGuard PayloadGuard(TEXT("FindAssetRegistryCollisions"));
+
+	FGuidFixerAssetRegistryObjectSource Source([this](const FAssetData& Asset) { return ShouldModifyPath(Asset.ObjectPath.ToString()); });
+	std::vector<FGuidFixerScanRecord> Records;
+	Source.ReadAll(Records);
+
+	FGuidFixerResolveOptions Options;
+	Options.bFixInvalid = false;
+	Options.bFixDuplicates = true;
+	const FGuidFixerResolution Resolution = FGuidFixerCollisionDetector::Resolve(Records, Options);
+
+	for (const uint32 Record : Resolution.InvalidRecords)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Asset has invalid GUID."), *Source.GetAsset(Records[Record].Identity).ObjectPath.ToString());
+	}
+
+	TArray<const FAssetData*> Colliding;
+	const int32 NumCollisions = Resolution.Collisions.size();
+	const int32 NumUntagged = Source.GetNumUntagged();
+	for (const FGuidFixerCollisionGroup& Group : Resolution.Collisions)
+	{
+		const FAssetData& First = Source.GetAsset(Records[Group.Records[0]].Identity);
+		Colliding.Add(&First);
+		for (size_t Index = 1; Index < Group.Records.size(); ++Index)
+		{
+			const FAssetData& Asset = Source.GetAsset(Records[Group.Records[Index]].Identity);
+			Colliding.Add(&Asset);
+			if (FGuidFixerTrackedGuids::MustBeUnique(Group.Kind))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s: Asset has conflicting GUID with %s."), *Asset.ObjectPath.ToString(), *First.ObjectPath.ToString());
+			}
+			else
+			{
+				// Registry data has no content hash, the fixers compare the source data once the textures are loaded
+				UE_LOG(LogTemp, Warning, TEXT("%s: Asset shares its %s GUID with %s, this is only a conflict if their content differs."), *Asset.ObjectPath.ToString(), *FGuidFixerTrackedGuids::KindToString(Group.Kind), *First.ObjectPath.ToString());
+			}
+		}
+	}
+
+	FString Message = NumCollisions > 0
+		? FString::Printf(TEXT("Found %d GUID collision(s) across %d asset(s) (Please refer to log)."), NumCollisions, Colliding.Num())
+		: FString(TEXT("No duplicate GUIDs found in the Asset Registry."));
+	if (NumUntagged > 0)
+	{
+		Message += FString::Printf(TEXT("\n\n%d asset(s) have no GUID tag and were not checked. Resave them to include them."), NumUntagged);
+	}
+
+	if (NumCollisions == 0)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
+		return;
+	}
+
+	// Loading only the colliding assets is enough for the fixers above to resolve them
+	Message += TEXT("\n\nLoad the colliding assets now so they can be fixed?");
+	if (FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(Message)) == EAppReturnType::Yes)
+	{
+		for (const FAssetData* Asset : Colliding)
+		{
+			Asset->GetAsset();
+		}
+	}
+}
+
+void FGuidFixerModule::RebuildGuidIndex()
+{
+	FGuidFixerPayloadGuard PayloadGuard(TEXT("RebuildGuidIndex"));
+
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bRebuilt = Index.Rebuild();
+
+	const FText DialogText = bRebuilt
+		? FText::FromString(FString::Printf(TEXT("GUID index rebuilt in %.2fs."), FPlatformTime::Seconds() - StartTime))
+		: FText::FromString("GUID index could not be written (Please refer to log).");
 	FMessageDialog::Open(EAppMsgType::Ok, DialogText);
 }
 
@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerAssetTags.h"
+#include "GuidFixerTrackedGuid.h"
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+#include "Sound/SoundWave.h"
+
+const FName FGuidFixerAssetTags::LightingGuidTag(TEXT("GuidFixerLightingGuid"));
+const FName FGuidFixerAssetTags::TextureSourceIdTag(TEXT("GuidFixerTextureSourceId"));
+const FName FGuidFixerAssetTags::CompressedDataGuidTag(TEXT("GuidFixerCompressedDataGuid"));
+const FName FGuidFixerAssetTags::MeshDescriptionIdsTag(TEXT("GuidFixerMeshDescriptionIds"));
+const FName FGuidFixerAssetTags::LevelBuildDataIdTag(TEXT("GuidFixerLevelBuildDataId"));
+
+FDelegateHandle FGuidFixerAssetTags::OnGetExtraObjectTagsHandle;
+
+void FGuidFixerAssetTags::Initialize()
+{
+	if (!OnGetExtraObjectTagsHandle.IsValid())
+	{
+		OnGetExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddStatic(&FGuidFixerAssetTags::OnGetExtraObjectTags);
+	}
+}
+
+void FGuidFixerAssetTags::Shutdown()
+{
+	UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(OnGetExtraObjectTagsHandle);
+	OnGetExtraObjectTagsHandle.Reset();
+}
+
+void FGuidFixerAssetTags::AddTrackedClasses(FARFilter& Filter)
+{
+	Filter.ClassNames.Add(UMaterialInterface::StaticClass()->GetFName());
+	Filter.ClassNames.Add(UTexture::StaticClass()->GetFName());
+	Filter.ClassNames.Add(USoundWave::StaticClass()->GetFName());
+	Filter.ClassNames.Add(UStaticMesh::StaticClass()->GetFName());
+	Filter.ClassNames.Add(UWorld::StaticClass()->GetFName());
+	Filter.bRecursiveClasses = true;
+}
+
+bool FGuidFixerAssetTags::GetTrackedGuids(const FAssetData& Asset, TArray<FGuidFixerTrackedGuid>& OutGuids)
+{
+	const UClass* AssetClass = Asset.GetClass();
+	const EGuidFixerGuidKind LightingKind = AssetClass && AssetClass->IsChildOf<UTexture>() ? EGuidFixerGuidKind::TextureLighting : EGuidFixerGuidKind::MaterialLighting;
+	const TPair<FName, EGuidFixerGuidKind> TagKinds[] =
+	{
+		{ LightingGuidTag, LightingKind },
+		{ TextureSourceIdTag, EGuidFixerGuidKind::TextureSource },
+		{ CompressedDataGuidTag, EGuidFixerGuidKind::SoundCompressedData },
+		{ MeshDescriptionIdsTag, EGuidFixerGuidKind::StaticMeshDescription },
+		{ LevelBuildDataIdTag, EGuidFixerGuidKind::LevelBuildData },
+	};
+
+	bool bHasTag = false;
+	FString TagValue;
+	TArray<FString> GuidStrings;
+	for (const TPair<FName, EGuidFixerGuidKind>& TagKind : TagKinds)
+	{
+		if (!Asset.GetTagValue(TagKind.Key, TagValue))
+		{
+			continue;
+		}
+
+		// Objects with several GUIDs of one kind list them comma separated
+		bHasTag = true;
+		TagValue.ParseIntoArray(GuidStrings, TEXT(","));
+		for (const FString& GuidString : GuidStrings)
+		{
+			FGuid Guid;
+			if (FGuid::Parse(GuidString, Guid))
+			{
+				OutGuids.Add({ TagKind.Value, FGuidFixerTrackedGuids::ToCore(Guid) });
+			}
+		}
+	}
+	return bHasTag;
+}
+
+FName FGuidFixerAssetTags::GetTag(EGuidFixerGuidKind Kind)
+{
+	switch (Kind)
+	{
+	case EGuidFixerGuidKind::MaterialLighting:
+	case EGuidFixerGuidKind::TextureLighting:
+		return LightingGuidTag;
+	case EGuidFixerGuidKind::TextureSource:
+		return TextureSourceIdTag;
+	case EGuidFixerGuidKind::SoundCompressedData:
+		return CompressedDataGuidTag;
+	case EGuidFixerGuidKind::StaticMeshDescription:
+		return MeshDescriptionIdsTag;
+	case EGuidFixerGuidKind::LevelBuildData:
+		return LevelBuildDataIdTag;
+	default:
+		return NAME_None;
+	}
+}
+
+void FGuidFixerAssetTags::OnGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& InOutTags)
+{
+	TArray<FGuidFixerTrackedGuid> Guids;
+	FGuidFixerTrackedGuids::GetAll(Object, Guids);
+
+	TMap<FName, FString> TagValues;
+	for (const FGuidFixerTrackedGuid& Tracked : Guids)
+	{
+		FString& TagValue = TagValues.FindOrAdd(GetTag(Tracked.Kind));
+		TagValue += (TagValue.IsEmpty() ? TEXT("") : TEXT(",")) + FGuidFixerTrackedGuids::ToEngine(Tracked.Guid).ToString();
+	}
+
+	// Mesh descriptions whose ID is a hash of their content aren't tracked, the tag still marks the mesh as saved with the plugin
+	if (Object && Object->IsA<UStaticMesh>() && !TagValues.Contains(MeshDescriptionIdsTag))
+	{
+		TagValues.Add(MeshDescriptionIdsTag, TEXT("None"));
+	}
+
+	for (const TPair<FName, FString>& TagValue : TagValues)
+	{
+		InOutTags.Add(UObject::FAssetRegistryTag(TagValue.Key, TagValue.Value, UObject::FAssetRegistryTag::TT_Hidden));
+	}
+}
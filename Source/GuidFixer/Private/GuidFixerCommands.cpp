@@ -16,6 +16,28 @@ void FGuidFixerCommands::RegisterCommands()
 	           "This will update empty texture GUIDs, which may help if the other fixes weren't enough to solve the issue.\n"
 	           "This will attempt to update engine textures, so will often report making changes that will be reset on restart.",
 	           EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(FixSoundWaveGuids, "Fix Sound Wave GUIDs",
+	           "Fixes the compressed data GUIDs of sound waves so that no two sounds share compressed audio in the derived data cache.",
+	           EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(FixStaticMeshGuids, "Fix Static Mesh GUIDs",
+	           "Fixes the mesh description IDs of static meshes so that no two meshes share derived mesh data.\n"
+	           "Colliding meshes get IDs derived from their mesh description, so meshes that really are identical still share derived data.",
+	           EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(FixGraphNodeGuids, "Fix Graph Node GUIDs",
+	           "Fixes nodes that share a GUID with another node in the same graph, as left behind by copy and paste between Blueprints.\n"
+	           "Covers every loaded graph, and Blueprints are not recompiled.",
+	           EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(FixLevelBuildDataIds, "Fix Level Build Data IDs",
+	           "Finds maps that share a level build data ID using Asset Registry data, and gives the copies a new one.\n"
+	           "The map with the oldest package file keeps its ID, the changed levels need their lighting rebuilt.",
+	           EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(FindAssetRegistryCollisions, "Find GUID Collisions (Asset Registry)",
+	           "Finds GUID collisions across the whole project using Asset Registry data, without loading any assets.\n"
+	           "Assets saved before this plugin was enabled have no GUID tag and need to be resaved to be included.",
+	           EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(RebuildGuidIndex, "Rebuild GUID Index",
+	           "Rebuilds the persisted GUID index from Asset Registry data. Saves made after this are appended to the index as they happen.",
+	           EUserInterfaceActionType::Button, FInputChord());
 }
 
 #undef LOCTEXT_NAMESPACE
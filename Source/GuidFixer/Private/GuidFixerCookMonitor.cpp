@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerCookMonitor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+void FGuidFixerCookMonitor::OnPackageCooked(const UPackage* Package)
+{
+	NumCookedPackages.Increment();
+
+	TArray<FGuidFixerTrackedGuid> PackageGuids;
+	FGuidFixerTrackedGuids::GetForPackage(Package, PackageGuids);
+
+	// Every platform saves the same package again, which is not a collision
+	const FName PackageName = Package->GetFName();
+	for (const FGuidFixerTrackedGuid& Tracked : PackageGuids)
+	{
+		const FGuid Guid = FGuidFixerTrackedGuids::ToEngine(Tracked.Guid);
+		FName ExistingPackageName;
+		if (!Guids[FMath::Min(uint32(Tracked.Kind), uint32(GUIDFIXER_INDEX_MAX_KINDS - 1))].FindOrAdd(Guid, PackageName, ExistingPackageName) && ExistingPackageName != PackageName)
+		{
+			FScopeLock Lock(&CollisionsLock);
+			Collisions.Add({ Tracked.Kind, Guid, PackageName, ExistingPackageName });
+		}
+	}
+}
+
+bool FGuidFixerCookMonitor::WriteReport() const
+{
+	FScopeLock Lock(&CollisionsLock);
+
+	// A package saved for several platforms collides once per platform, the report lists each pair once
+	TSet<FString> Lines;
+	for (const FCollision& Collision : Collisions)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%s,%s,%s"), *FGuidFixerTrackedGuids::KindToString(Collision.Kind), *Collision.Guid.ToString(), *Collision.PackageName.ToString(), *Collision.ExistingPackageName.ToString()));
+	}
+	TArray<FString> SortedLines = Lines.Array();
+	SortedLines.Sort();
+	SortedLines.Insert(TEXT("Kind,Guid,Package,ConflictingPackage"), 0);
+
+	const FString Filename = GetReportFilename();
+	if (!FFileHelper::SaveStringArrayToFile(SortedLines, *Filename))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Could not write the cook GUID collision report."), *Filename);
+		return false;
+	}
+
+	if (SortedLines.Num() > 1)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Found %d GUID collision(s) in %d cooked package save(s), see %s. Fix them with Tools -> GUID Fixer in the editor."), SortedLines.Num() - 1, GetNumCookedPackages(), *Filename);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Display, TEXT("No GUID collisions in %d cooked package save(s), report written to %s."), GetNumCookedPackages(), *Filename);
+	}
+	return true;
+}
+
+void FGuidFixerCookMonitor::Reset()
+{
+	for (TGuidFixerConcurrentGuidMap<FName>& KindGuids : Guids)
+	{
+		KindGuids.Empty();
+	}
+
+	FScopeLock Lock(&CollisionsLock);
+	Collisions.Reset();
+	NumCookedPackages.Reset();
+}
+
+FString FGuidFixerCookMonitor::GetReportFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GuidFixer") / TEXT("CookCollisions.csv");
+}
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GuidFixerConcurrentGuidMap.h"
+#include "GuidFixerIndexFormat.h"
+#include "GuidFixerTrackedGuid.h"
+
+/**
+ * Collects tracked GUIDs from packages as the cook saves them, so collisions are found without a scan of their own.
+ * A cook loads and saves every package anyway, and only reading GUIDs that are already in memory adds next to nothing to it.
+ */
+class FGuidFixerCookMonitor
+{
+public:
+
+	/** Records the tracked GUIDs of a package saved for a target platform, can be called from any thread */
+	void OnPackageCooked(const UPackage* Package);
+
+	/** @return the number of package saves seen, one per package and target platform */
+	int32 GetNumCookedPackages() const { return NumCookedPackages.GetValue(); }
+
+	/** Writes every collision seen as CSV and logs a summary, @return false if the report couldn't be written */
+	bool WriteReport() const;
+
+	/** Forgets every GUID, collision and package save seen, so the next cook in the same process starts from nothing */
+	void Reset();
+
+	static FString GetReportFilename();
+
+private:
+
+	struct FCollision
+	{
+		EGuidFixerGuidKind Kind;
+		FGuid Guid;
+		FName PackageName;
+		FName ExistingPackageName;
+	};
+
+	/** First package seen with each GUID, one map per kind since kinds are separate GUID spaces */
+	TGuidFixerConcurrentGuidMap<FName> Guids[GUIDFIXER_INDEX_MAX_KINDS];
+
+	mutable FCriticalSection CollisionsLock;
+	TArray<FCollision> Collisions;
+
+	FThreadSafeCounter NumCookedPackages;
+};
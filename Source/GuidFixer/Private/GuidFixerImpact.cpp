@@ -0,0 +1,235 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerImpact.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Components/PrimitiveComponent.h"
+#include "Editor.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Scalability.h"
+
+#define LOCTEXT_NAMESPACE "FGuidFixerModule"
+
+/** @return the world package that owns a World Partition external actor package, or NAME_None for any other package */
+static FName FindExternalActorLevel(const IAssetRegistry& AssetRegistry, const FName PackageName)
+{
+	static const FString ExternalActorsFolder = TEXT("/__ExternalActors__/");
+
+	const FString PackageNameString = PackageName.ToString();
+	const int32 FolderIndex = PackageNameString.Find(ExternalActorsFolder, ESearchCase::IgnoreCase);
+	if (FolderIndex == INDEX_NONE)
+	{
+		return NAME_None;
+	}
+
+	// Actor packages sit a few hashed folders below a folder mirroring the path of their level
+	FString LevelPath = PackageNameString.Left(FolderIndex + 1) + PackageNameString.RightChop(FolderIndex + ExternalActorsFolder.Len());
+	const FName WorldClassName = UWorld::StaticClass()->GetFName();
+	TArray<FAssetData> Assets;
+	while (LevelPath.Split(TEXT("/"), &LevelPath, nullptr, ESearchCase::CaseSensitive, ESearchDir::FromEnd) && !LevelPath.IsEmpty())
+	{
+		Assets.Reset();
+		AssetRegistry.GetAssetsByPackageName(FName(*LevelPath), Assets, true);
+		if (Assets.ContainsByPredicate([WorldClassName](const FAssetData& Asset) { return Asset.AssetClass == WorldClassName; }))
+		{
+			return FName(*LevelPath);
+		}
+	}
+	return NAME_None;
+}
+
+FGuidFixerImpact FGuidFixerImpact::Estimate(const TSet<FName>& PackageNames, bool bAffectsLighting, bool bAffectsStreaming)
+{
+	FGuidFixerImpact Impact;
+
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	const FName WorldClassName = UWorld::StaticClass()->GetFName();
+
+	// Breadth first over package referencers, a texture is usually reached through materials and meshes before a level
+	TSet<FName> Visited(PackageNames);
+	TArray<FName> Pending = PackageNames.Array();
+	TArray<FName> Referencers;
+	TArray<FAssetData> Assets;
+	while (Pending.Num() > 0)
+	{
+		const FName PackageName = Pending.Pop(false);
+
+		Referencers.Reset();
+		AssetRegistry.GetReferencers(PackageName, Referencers);
+		for (const FName Referencer : Referencers)
+		{
+			bool bAlreadyVisited = false;
+			Visited.Add(Referencer, &bAlreadyVisited);
+			if (bAlreadyVisited)
+			{
+				continue;
+			}
+
+			// World Partition levels don't reference their actors, the actor packages reference whatever they use instead
+			const FName ExternalActorLevel = FindExternalActorLevel(AssetRegistry, Referencer);
+			if (!ExternalActorLevel.IsNone())
+			{
+				if (bAffectsLighting)
+				{
+					Impact.LightingLevels.Add(ExternalActorLevel);
+				}
+				if (bAffectsStreaming)
+				{
+					Impact.StreamingLevels.Add(ExternalActorLevel);
+				}
+				continue;
+			}
+
+			Assets.Reset();
+			AssetRegistry.GetAssetsByPackageName(Referencer, Assets, true);
+
+			bool bIsLevel = false;
+			for (const FAssetData& Asset : Assets)
+			{
+				if (Asset.AssetClass == WorldClassName)
+				{
+					bIsLevel = true;
+				}
+				else if (const UClass* AssetClass = Asset.GetClass())
+				{
+					if (AssetClass->IsChildOf<UMaterialInterface>())
+					{
+						Impact.DependentMaterials.Add(Referencer);
+					}
+				}
+			}
+
+			// Levels are where the walk stops, anything referencing a level doesn't depend on its built data
+			if (bIsLevel)
+			{
+				if (bAffectsLighting)
+				{
+					Impact.LightingLevels.Add(Referencer);
+				}
+				if (bAffectsStreaming)
+				{
+					Impact.StreamingLevels.Add(Referencer);
+				}
+				continue;
+			}
+
+			Pending.Add(Referencer);
+		}
+	}
+
+	return Impact;
+}
+
+bool FGuidFixerImpact::IsEmpty() const
+{
+	return LightingLevels.Num() == 0 && StreamingLevels.Num() == 0 && DependentMaterials.Num() == 0;
+}
+
+/** @return the levels of the editor world whose package is one of PackageNames, the rest are added to OutUnloaded */
+static TArray<ULevel*> GetLoadedLevels(const TSet<FName>& PackageNames, TSet<FName>& OutUnloaded)
+{
+	TArray<ULevel*> Levels;
+	OutUnloaded = PackageNames;
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return Levels;
+	}
+
+	for (ULevel* Level : World->GetLevels())
+	{
+		const FName PackageName = Level->GetPackage()->GetFName();
+		if (PackageNames.Contains(PackageName))
+		{
+			Levels.Add(Level);
+			OutUnloaded.Remove(PackageName);
+		}
+	}
+	return Levels;
+}
+
+int32 FGuidFixerImpact::RebuildTextureStreaming() const
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World || StreamingLevels.Num() == 0)
+	{
+		return 0;
+	}
+
+	TSet<FName> UnloadedLevels;
+	const TArray<ULevel*> Levels = GetLoadedLevels(StreamingLevels, UnloadedLevels);
+	for (const FName PackageName : UnloadedLevels)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Level is not loaded, texture streaming needs to be rebuilt the next time it is opened."), *PackageName.ToString());
+	}
+
+	// Components read material and render state while building, so this has to stay on the game thread
+	// What keeps it fast is that only the levels referencing a changed texture are visited
+	const EMaterialQualityLevel::Type QualityLevel = Scalability::GetCachedScalabilityCVars().MaterialQualityLevel;
+	const ERHIFeatureLevel::Type FeatureLevel = World->FeatureLevel;
+
+	FScopedSlowTask SlowTask(Levels.Num(), LOCTEXT("RebuildTextureStreaming", "Rebuilding texture streaming for affected levels"));
+	SlowTask.MakeDialog();
+	for (ULevel* Level : Levels)
+	{
+		SlowTask.EnterProgressFrame();
+
+		TSet<FGuid> DependentResources;
+		Level->NumTextureStreamingUnbuiltComponents = 0;
+		Level->StreamingTextureGuids.Reset();
+		for (AActor* Actor : Level->Actors)
+		{
+			if (!Actor)
+			{
+				continue;
+			}
+
+			TInlineComponentArray<UPrimitiveComponent*> Primitives;
+			Actor->GetComponents(Primitives);
+			for (UPrimitiveComponent* Primitive : Primitives)
+			{
+				if (!Primitive->BuildTextureStreamingData(TSB_MapBuild, QualityLevel, FeatureLevel, DependentResources))
+				{
+					++Level->NumTextureStreamingUnbuiltComponents;
+				}
+			}
+		}
+
+		Level->TextureStreamingResourceGuids = DependentResources.Array();
+		Level->NumTextureStreamingDirtyResources = 0;
+		Level->MarkPackageDirty();
+		UE_LOG(LogTemp, Display, TEXT("%s: Level has had its texture streaming data rebuilt."), *Level->GetPackage()->GetName());
+	}
+
+	return Levels.Num();
+}
+
+int32 FGuidFixerImpact::InvalidateLighting() const
+{
+	if (LightingLevels.Num() == 0)
+	{
+		return 0;
+	}
+
+	TSet<FName> UnloadedLevels;
+	const TArray<ULevel*> Levels = GetLoadedLevels(LightingLevels, UnloadedLevels);
+
+	// Components compare their lighting GUIDs against the build data when their render state is created,
+	// recreating it is what makes the editor report the stale lighting as unbuilt
+	for (ULevel* Level : Levels)
+	{
+		Level->MarkLevelComponentsRenderStateDirty();
+	}
+	return Levels.Num();
+}
+
+FString FGuidFixerImpact::ToString() const
+{
+	return FString::Printf(TEXT("%d level(s) will need lighting rebuilt, %d level(s) will need texture streaming rebuilt and %d material(s) may have their derived data invalidated."),
+		LightingLevels.Num(), StreamingLevels.Num(), DependentMaterials.Num());
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What has to be rebuilt once a set of GUIDs is changed */
+struct FGuidFixerImpact
+{
+	/** Levels whose built lighting references a changed asset */
+	TSet<FName> LightingLevels;
+
+	/** Levels whose texture streaming data references a changed asset */
+	TSet<FName> StreamingLevels;
+
+	/** Materials that reference a changed asset, their cached derived data may be invalidated */
+	TSet<FName> DependentMaterials;
+
+	/** Walks the asset registry referencers of the given packages, World Partition actor packages count towards their level, nothing is loaded */
+	static FGuidFixerImpact Estimate(const TSet<FName>& PackageNames, bool bAffectsLighting, bool bAffectsStreaming);
+
+	bool IsEmpty() const;
+
+	/**
+	 * Rebuilds texture streaming data for the streaming levels that are loaded in the editor world, leaving every other level alone.
+	 * @return number of levels rebuilt, affected levels that aren't loaded are logged instead
+	 */
+	int32 RebuildTextureStreaming() const;
+
+	/**
+	 * Makes the lighting levels that are loaded in the editor world re-evaluate whether their built lighting is still valid.
+	 * @return number of levels invalidated
+	 */
+	int32 InvalidateLighting() const;
+
+	FString ToString() const;
+};
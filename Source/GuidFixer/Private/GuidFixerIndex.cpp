@@ -0,0 +1,267 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerIndex.h"
+#include "GuidFixerIndexWriter.h"
+#include "GuidFixerAssetTags.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static std::string PackageNameToUtf8(FName PackageName)
+{
+	const FTCHARToUTF8 Path(*PackageName.ToString());
+	return std::string(Path.Get(), Path.Length());
+}
+
+static FName Utf8ToPackageName(const std::string& Path)
+{
+	const FUTF8ToTCHAR PackageName(Path.data(), Path.size());
+	return FName(FString(PackageName.Length(), PackageName.Get()));
+}
+
+static bool WriteFile(const FString& Filename, const std::vector<uint8_t>& Data, uint32 WriteFlags = 0)
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename, WriteFlags));
+	if (!Writer.IsValid())
+	{
+		return false;
+	}
+
+	Writer->Serialize(const_cast<uint8_t*>(Data.data()), Data.size());
+	return Writer->Close();
+}
+
+void FGuidFixerIndex::FLayer::SetPackage(FName PackageName, TArray<FGuidFixerTrackedGuid>&& Guids)
+{
+	RemovePackage(PackageName);
+	for (const FGuidFixerTrackedGuid& Tracked : Guids)
+	{
+		Owners.Add(FGuidFixerTrackedGuids::ToEngine(Tracked.Guid), PackageName);
+	}
+	Packages.Add(PackageName, MoveTemp(Guids));
+}
+
+void FGuidFixerIndex::FLayer::RemovePackage(FName PackageName)
+{
+	TArray<FGuidFixerTrackedGuid> Guids;
+	if (Packages.RemoveAndCopyValue(PackageName, Guids))
+	{
+		for (const FGuidFixerTrackedGuid& Tracked : Guids)
+		{
+			Owners.RemoveSingle(FGuidFixerTrackedGuids::ToEngine(Tracked.Guid), PackageName);
+		}
+	}
+}
+
+void FGuidFixerIndex::FLayer::Find(const FGuid& Guid, TArray<FGuidFixerIndexOwner>& OutOwners) const
+{
+	TArray<FName, TInlineAllocator<4>> PackageNames;
+	Owners.MultiFind(Guid, PackageNames);
+	for (const FName PackageName : PackageNames)
+	{
+		// A package can own the same GUID under more than one kind, report each of them once
+		if (OutOwners.ContainsByPredicate([PackageName](const FGuidFixerIndexOwner& Owner) { return Owner.PackageName == PackageName; }))
+		{
+			continue;
+		}
+
+		for (const FGuidFixerTrackedGuid& Tracked : Packages.FindChecked(PackageName))
+		{
+			if (FGuidFixerTrackedGuids::ToEngine(Tracked.Guid) == Guid)
+			{
+				OutOwners.Add({ PackageName, Tracked.Kind });
+			}
+		}
+	}
+}
+
+FGuidFixerIndex::FGuidFixerIndex()
+{
+}
+
+FGuidFixerIndex::~FGuidFixerIndex()
+{
+	Close();
+}
+
+FString FGuidFixerIndex::GetBaseFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GuidFixer") / TEXT("GuidIndex.bin");
+}
+
+FString FGuidFixerIndex::GetLogFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GuidFixer") / TEXT("GuidIndex.log");
+}
+
+bool FGuidFixerIndex::Open()
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	BaseHandle.Reset(PlatformFile.OpenMapped(*GetBaseFilename()));
+	if (!BaseHandle.IsValid() || BaseHandle->GetFileSize() == 0)
+	{
+		Close();
+		return false;
+	}
+
+	BaseRegion.Reset(BaseHandle->MapRegion(0, BaseHandle->GetFileSize()));
+	if (!BaseRegion.IsValid() || !Reader.Initialize(BaseRegion->GetMappedPtr(), BaseRegion->GetMappedSize()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: GUID index is out of date or corrupt, rebuild it with Tools -> GUID Fixer -> Rebuild GUID Index."), *GetBaseFilename());
+		Close();
+		return false;
+	}
+
+	TArray<uint8> LogData;
+	if (FFileHelper::LoadFileToArray(LogData, *GetLogFilename(), FILEREAD_Silent))
+	{
+		Reader.ReplayLog(LogData.GetData(), LogData.Num());
+	}
+	return true;
+}
+
+void FGuidFixerIndex::Close()
+{
+	// The reader views the region, and the region has to go before the handle it was mapped from
+	Reader = FGuidFixerIndexReader();
+	BaseRegion.Reset();
+	BaseHandle.Reset();
+}
+
+bool FGuidFixerIndex::IsOpen() const
+{
+	return Reader.IsValid();
+}
+
+bool FGuidFixerIndex::Rebuild()
+{
+	// The current base stays open until the new one is on disk, so a failed rebuild leaves the index usable
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	FARFilter Filter;
+	FGuidFixerAssetTags::AddTrackedClasses(Filter);
+	Filter.bIncludeOnlyOnDiskAssets = true;
+
+	TMap<FName, TArray<FGuidFixerTrackedGuid>> PackageGuids;
+	AssetRegistry.EnumerateAssets(Filter, [&PackageGuids](const FAssetData& Asset)
+	{
+		TArray<FGuidFixerTrackedGuid> Guids;
+		if (Asset.IsRedirector() || !FGuidFixerAssetTags::GetTrackedGuids(Asset, Guids))
+		{
+			return true;
+		}
+
+		// The index only holds valid GUIDs that must be unique, the same as FGuidFixerTrackedGuids::Get() reports for saved packages
+		TArray<FGuidFixerTrackedGuid>& Tracked = PackageGuids.FindOrAdd(Asset.PackageName);
+		for (const FGuidFixerTrackedGuid& Guid : Guids)
+		{
+			if (Guid.Guid.IsValid() && FGuidFixerTrackedGuids::MustBeUnique(Guid.Kind))
+			{
+				Tracked.Add(Guid);
+			}
+		}
+		return true;
+	});
+
+	std::vector<FGuidFixerIndexPackage> Packages;
+	Packages.reserve(PackageGuids.Num());
+	int32 NumRecords = 0;
+	for (const TPair<FName, TArray<FGuidFixerTrackedGuid>>& Package : PackageGuids)
+	{
+		Packages.push_back({ PackageNameToUtf8(Package.Key), std::vector<FGuidFixerTrackedGuid>(Package.Value.GetData(), Package.Value.GetData() + Package.Value.Num()) });
+		NumRecords += Package.Value.Num();
+	}
+
+	// Written next to the old base and moved over it, so a failed write never leaves a truncated index behind
+	const FString Filename = GetBaseFilename();
+	const FString TempFilename = Filename + TEXT(".tmp");
+	const std::vector<uint8_t> Data = FGuidFixerIndexWriter::WriteBase(Packages);
+	if (!WriteFile(TempFilename, Data))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s: GUID index could not be written, the previous index is still in use."), *TempFilename);
+		IFileManager::Get().Delete(*TempFilename, false, true, true);
+		return false;
+	}
+
+	// A mapped file can't be replaced on every platform, so the base is only unmapped for the move
+	const bool bWasOpen = IsOpen();
+	Close();
+	if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s: GUID index could not be replaced, the previous index is still in use."), *Filename);
+		IFileManager::Get().Delete(*TempFilename, false, true, true);
+		if (bWasOpen)
+		{
+			Open();
+		}
+		return false;
+	}
+	UE_LOG(LogTemp, Display, TEXT("Wrote GUID index with %d GUID(s) across %d package(s) to %s, %llu byte(s)."), NumRecords, PackageGuids.Num(), *Filename, uint64(Data.size()));
+
+	// Everything the log held is part of the new base now
+	IFileManager::Get().Delete(*GetLogFilename(), false, true, true);
+	return Open();
+}
+
+void FGuidFixerIndex::MarkPackageDirty(const UPackage* Package)
+{
+	DirtyPackages.Add(Package->GetFName());
+}
+
+void FGuidFixerIndex::CommitPackage(const UPackage* Package)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	const FName PackageName = Package->GetFName();
+	TArray<FGuidFixerTrackedGuid> Guids;
+	FGuidFixerTrackedGuids::GetForPackage(Package, Guids);
+
+	FGuidFixerIndexPackage Record{ PackageNameToUtf8(PackageName), std::vector<FGuidFixerTrackedGuid>(Guids.GetData(), Guids.GetData() + Guids.Num()) };
+	std::vector<uint8_t> Data;
+	FGuidFixerIndexWriter::AppendLogRecord(Record, Data);
+	WriteFile(GetLogFilename(), Data, FILEWRITE_Append | FILEWRITE_AllowRead);
+
+	Reader.SetPackage(Record.Path, MoveTemp(Record.Guids));
+	Session.RemovePackage(PackageName);
+	DirtyPackages.Remove(PackageName);
+}
+
+void FGuidFixerIndex::Find(const FGuid& Guid, TArray<FGuidFixerIndexOwner>& OutOwners) const
+{
+	FlushDirtyPackages();
+
+	Session.Find(Guid, OutOwners);
+
+	std::vector<FGuidFixerIndexEntry> Entries;
+	Reader.FindOwners(FGuidFixerTrackedGuids::ToCore(Guid), Entries);
+	for (const FGuidFixerIndexEntry& Entry : Entries)
+	{
+		const FName PackageName = Utf8ToPackageName(Entry.Package);
+		if (!Session.Packages.Contains(PackageName))
+		{
+			OutOwners.Add({ PackageName, Entry.Kind });
+		}
+	}
+}
+
+void FGuidFixerIndex::FlushDirtyPackages() const
+{
+	for (const FName PackageName : DirtyPackages)
+	{
+		if (const UPackage* Package = FindPackage(nullptr, *PackageName.ToString()))
+		{
+			TArray<FGuidFixerTrackedGuid> Guids;
+			FGuidFixerTrackedGuids::GetForPackage(Package, Guids);
+			Session.SetPackage(PackageName, MoveTemp(Guids));
+		}
+	}
+	DirtyPackages.Reset();
+}
@@ -0,0 +1,123 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerObjectSources.h"
+#include "GuidFixerAssetTags.h"
+#include "GuidFixerTrackedGuid.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/UObjectHash.h"
+
+static std::string ToUtf8(const FString& String)
+{
+	const FTCHARToUTF8 Utf8(*String);
+	return std::string(Utf8.Get(), Utf8.Length());
+}
+
+FGuidFixerLoadedObjectSource::FGuidFixerLoadedObjectSource(UClass* Class, TFunction<bool(const UObject*)> InIsModifiable)
+	: IsModifiable(MoveTemp(InIsModifiable))
+{
+	GetObjectsOfClass(Class, Objects, true);
+}
+
+size_t FGuidFixerLoadedObjectSource::NextBatch(std::vector<FGuidFixerScanRecord>& OutRecords, size_t MaxRecords)
+{
+	size_t NumAdded = 0;
+	for (; NextObject < Objects.Num() && NumAdded < MaxRecords; ++NextObject)
+	{
+		Guids.Reset();
+		FGuidFixerTrackedGuids::GetAll(Objects[NextObject], Guids);
+		const bool bModifiable = IsModifiable(Objects[NextObject]);
+		for (const FGuidFixerTrackedGuid& Tracked : Guids)
+		{
+			OutRecords.push_back({ uint64_t(NextObject), Tracked.Kind, Tracked.Guid, bModifiable });
+			++NumAdded;
+		}
+	}
+	return NumAdded;
+}
+
+std::string FGuidFixerLoadedObjectSource::DescribeIdentity(uint64_t Identity) const
+{
+	return ToUtf8(Objects[Identity]->GetPathName());
+}
+
+FGuidFixerAssetRegistryObjectSource::FGuidFixerAssetRegistryObjectSource(TFunction<bool(const FAssetData&)> InIsModifiable, UClass* Class)
+	: IsModifiable(MoveTemp(InIsModifiable))
+{
+	FARFilter Filter;
+	if (Class)
+	{
+		Filter.ClassNames.Add(Class->GetFName());
+		Filter.bRecursiveClasses = true;
+	}
+	else
+	{
+		FGuidFixerAssetTags::AddTrackedClasses(Filter);
+	}
+
+	// Redirectors are not an instance of any tracked class, so the filter above never returns them
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.GetAssets(Filter, Assets);
+	VisitedObjectPaths.Reserve(Assets.Num());
+	for (const FAssetData& Asset : Assets)
+	{
+		VisitedObjectPaths.Add(Asset.ObjectPath);
+	}
+
+	FARFilter RedirectorFilter;
+	RedirectorFilter.ClassNames.Add(UObjectRedirector::StaticClass()->GetFName());
+	TArray<FAssetData> Redirectors;
+	AssetRegistry.GetAssets(RedirectorFilter, Redirectors);
+
+	// Moves and renames leave redirectors behind, each is resolved from registry data so every real asset is yielded once
+	TArray<FAssetData> Destinations;
+	for (const FAssetData& Redirector : Redirectors)
+	{
+		const FName DestinationPath = AssetRegistry.GetRedirectedObjectPath(Redirector.ObjectPath);
+		bool bAlreadyVisited = false;
+		VisitedObjectPaths.Add(DestinationPath, &bAlreadyVisited);
+		if (bAlreadyVisited || DestinationPath == Redirector.ObjectPath)
+		{
+			continue;
+		}
+
+		const FAssetData Destination = AssetRegistry.GetAssetByObjectPath(DestinationPath, true);
+		if (Destination.IsValid() && !Destination.IsRedirector())
+		{
+			Destinations.Add(Destination);
+		}
+	}
+
+	AssetRegistry.RunAssetsThroughFilter(Destinations, Filter);
+	Assets.Append(MoveTemp(Destinations));
+}
+
+size_t FGuidFixerAssetRegistryObjectSource::NextBatch(std::vector<FGuidFixerScanRecord>& OutRecords, size_t MaxRecords)
+{
+	// Only cached registry data is read, nothing here loads a package
+	size_t NumAdded = 0;
+	for (; NextAsset < Assets.Num() && NumAdded < MaxRecords; ++NextAsset)
+	{
+		const FAssetData& Asset = Assets[NextAsset];
+
+		Guids.Reset();
+		if (!FGuidFixerAssetTags::GetTrackedGuids(Asset, Guids))
+		{
+			++NumUntagged;
+			continue;
+		}
+
+		const bool bModifiable = IsModifiable(Asset);
+		for (const FGuidFixerTrackedGuid& Tracked : Guids)
+		{
+			OutRecords.push_back({ uint64_t(NextAsset), Tracked.Kind, Tracked.Guid, bModifiable });
+			++NumAdded;
+		}
+	}
+	return NumAdded;
+}
+
+std::string FGuidFixerAssetRegistryObjectSource::DescribeIdentity(uint64_t Identity) const
+{
+	return ToUtf8(Assets[Identity].ObjectPath.ToString());
+}
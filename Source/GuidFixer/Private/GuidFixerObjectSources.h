@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "GuidFixerObjectSource.h"
+
+/** Yields the tracked GUIDs of every loaded object of a class, identities are indices of GetObject() */
+class FGuidFixerLoadedObjectSource : public IGuidFixerObjectSource
+{
+public:
+
+	FGuidFixerLoadedObjectSource(UClass* Class, TFunction<bool(const UObject*)> InIsModifiable);
+
+	virtual size_t NextBatch(std::vector<FGuidFixerScanRecord>& OutRecords, size_t MaxRecords) override;
+	virtual std::string DescribeIdentity(uint64_t Identity) const override;
+	virtual const char* GetName() const override { return "LoadedObjects"; }
+
+	UObject* GetObject(uint64_t Identity) const { return Objects[Identity]; }
+
+private:
+
+	TArray<UObject*> Objects;
+	TArray<FGuidFixerTrackedGuid> Guids;
+	TFunction<bool(const UObject*)> IsModifiable;
+	int32 NextObject = 0;
+};
+
+/**
+ * Yields the GUID tags of every tracked asset in the Asset Registry without loading anything, identities are
+ * indices of GetAsset(). Assets reached through a redirector are only yielded once, and untagged assets are counted instead.
+ * If Class is set, only assets of that class are yielded.
+ */
+class FGuidFixerAssetRegistryObjectSource : public IGuidFixerObjectSource
+{
+public:
+
+	explicit FGuidFixerAssetRegistryObjectSource(TFunction<bool(const FAssetData&)> InIsModifiable, UClass* Class = nullptr);
+
+	virtual size_t NextBatch(std::vector<FGuidFixerScanRecord>& OutRecords, size_t MaxRecords) override;
+	virtual std::string DescribeIdentity(uint64_t Identity) const override;
+	virtual const char* GetName() const override { return "AssetRegistry"; }
+
+	const FAssetData& GetAsset(uint64_t Identity) const { return Assets[Identity]; }
+
+	/** @return the number of assets skipped so far for having no GUID tag */
+	int32 GetNumUntagged() const { return NumUntagged; }
+
+private:
+
+	TArray<FAssetData> Assets;
+	TSet<FName> VisitedObjectPaths;
+	TArray<FGuidFixerTrackedGuid> Guids;
+	TFunction<bool(const FAssetData&)> IsModifiable;
+	int32 NextAsset = 0;
+	int32 NumUntagged = 0;
+};
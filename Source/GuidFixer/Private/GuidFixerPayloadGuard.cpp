@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerPayloadGuard.h"
+
+using UE::Virtualization::IVirtualizationSystem;
+
+FGuidFixerPayloadGuard::FGuidFixerPayloadGuard(const TCHAR* InScanName)
+	: ScanName(InScanName)
+	, NumPulls(0)
+{
+	if (!CanReadPayloads())
+	{
+		OnNotificationHandle = IVirtualizationSystem::Get().GetNotificationEvent().AddRaw(this, &FGuidFixerPayloadGuard::OnNotification);
+	}
+}
+
+FGuidFixerPayloadGuard::~FGuidFixerPayloadGuard()
+{
+	if (!OnNotificationHandle.IsValid())
+	{
+		return;
+	}
+
+	IVirtualizationSystem::Get().GetNotificationEvent().Remove(OnNotificationHandle);
+	if (NumPulls.Load() > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s: %d virtualized payload(s) were pulled while scanning, scans are expected to never hydrate bulk data."), ScanName, NumPulls.Load());
+	}
+}
+
+bool FGuidFixerPayloadGuard::CanReadPayloads()
+{
+	return !IVirtualizationSystem::Get().IsEnabled();
+}
+
+void FGuidFixerPayloadGuard::OnNotification(IVirtualizationSystem::ENotification Notification, const FIoHash& Id)
+{
+	// Pulls can be issued from worker threads, and are broadcast before any backend is asked for the payload
+	if (Notification == IVirtualizationSystem::ENotification::PullBegunNotification)
+	{
+		++NumPulls;
+		ensureMsgf(false, TEXT("%s: Payload %s is being pulled from a virtualization backend."), ScanName, *LexToString(Id));
+	}
+}
@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Virtualization/IVirtualizationSystem.h"
+
+/**
+ * Watches the virtualization system for payload pulls while a scan is running.
+ * Scans only ever need metadata, so any pull is a bug. It is raised as an ensure when the pull begins, so the
+ * callstack of the read that asked for it is captured, and the total is reported when the guard goes out of scope.
+ */
+class FGuidFixerPayloadGuard
+{
+public:
+
+	explicit FGuidFixerPayloadGuard(const TCHAR* InScanName);
+
+	~FGuidFixerPayloadGuard();
+
+	/** @return false if reading a payload that isn't resident could pull it from a virtualization backend */
+	static bool CanReadPayloads();
+
+	/** @return true if pulls are being watched, which is only the case while virtualization is enabled */
+	bool IsWatching() const { return OnNotificationHandle.IsValid(); }
+
+	int32 GetNumPulls() const { return NumPulls.Load(); }
+
+private:
+
+	void OnNotification(UE::Virtualization::IVirtualizationSystem::ENotification Notification, const FIoHash& Id);
+
+private:
+
+	const TCHAR* ScanName;
+
+	TAtomic<int32> NumPulls;
+
+	FDelegateHandle OnNotificationHandle;
+};
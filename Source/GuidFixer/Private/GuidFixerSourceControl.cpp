@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerSourceControl.h"
+#include "HAL/FileManager.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
+#include "Misc/Paths.h"
+#include "SourceControlHelpers.h"
+#include "SourceControlOperations.h"
+
+static FString GetNormalizedFilename(const FString& Filename)
+{
+	FString Normalized = FPaths::ConvertRelativePathToFull(Filename);
+	FPaths::NormalizeFilename(Normalized);
+	return Normalized;
+}
+
+/**
+ * Pairs the states GetState returned with the files they were requested for. States come back in request order, but the
+ * filenames in them can be normalized differently by the provider, so names are only compared if the counts don't match.
+ * @return the index into Filenames of each state, INDEX_NONE for a state that matches none of them
+ */
+static TArray<int32> MatchStates(const TArray<FString>& Filenames, const TArray<FSourceControlStateRef>& States)
+{
+	TArray<int32> StateFiles;
+	StateFiles.Reserve(States.Num());
+	if (States.Num() == Filenames.Num())
+	{
+		for (int32 Index = 0; Index < States.Num(); ++Index)
+		{
+			StateFiles.Add(Index);
+		}
+		return StateFiles;
+	}
+
+	TMap<FString, int32> FileIndices;
+	for (int32 Index = 0; Index < Filenames.Num(); ++Index)
+	{
+		FileIndices.Add(GetNormalizedFilename(Filenames[Index]), Index);
+	}
+	for (const FSourceControlStateRef& State : States)
+	{
+		const int32* FileIndex = FileIndices.Find(GetNormalizedFilename(State->GetFilename()));
+		StateFiles.Add(FileIndex ? *FileIndex : INDEX_NONE);
+	}
+	return StateFiles;
+}
+
+TSet<FName> FGuidFixerSourceControl::CheckOutPackages(const TSet<FName>& PackageNames)
+{
+	TSet<FName> Uneditable;
+	if (PackageNames.Num() == 0)
+	{
+		return Uneditable;
+	}
+
+	// Filenames and FilePackages are parallel, so a package is found from its position rather than its filename
+	TArray<FString> Filenames;
+	TArray<FName> FilePackages;
+	Filenames.Reserve(PackageNames.Num());
+	FilePackages.Reserve(PackageNames.Num());
+	for (const FName PackageName : PackageNames)
+	{
+		Filenames.Add(SourceControlHelpers::PackageFilename(PackageName.ToString()));
+		FilePackages.Add(PackageName);
+	}
+
+	ISourceControlModule& SourceControlModule = ISourceControlModule::Get();
+	if (SourceControlModule.IsEnabled() && SourceControlModule.GetProvider().IsAvailable())
+	{
+		ISourceControlProvider& Provider = SourceControlModule.GetProvider();
+		const double StartTime = FPlatformTime::Seconds();
+
+		// Per-file requests are a round trip each, so the state of every file is fetched at once
+		TArray<FSourceControlStateRef> States;
+		Provider.GetState(Filenames, States, EStateCacheUsage::ForceUpdate);
+		TArray<int32> StateFiles = MatchStates(Filenames, States);
+
+		// A package whose state is unknown can't be known to be editable
+		TBitArray<> HasState(false, Filenames.Num());
+		for (const int32 File : StateFiles)
+		{
+			if (File != INDEX_NONE)
+			{
+				HasState[File] = true;
+			}
+		}
+		for (int32 File = 0; File < Filenames.Num(); ++File)
+		{
+			if (!HasState[File])
+			{
+				Uneditable.Add(FilePackages[File]);
+				UE_LOG(LogTemp, Warning, TEXT("%s: %s returned no state for the package, its GUIDs are left unchanged."), *Filenames[File], *Provider.GetName().ToString());
+			}
+		}
+
+		TArray<FString> ToCheckOut;
+		TArray<FName> ToCheckOutPackages;
+		int32 NumFailed = 0;
+		for (int32 Index = 0; Index < States.Num(); ++Index)
+		{
+			const FSourceControlStateRef& State = States[Index];
+			const int32 File = StateFiles[Index];
+			if (File == INDEX_NONE)
+			{
+				continue;
+			}
+
+			if (State->CanCheckout())
+			{
+				ToCheckOut.Add(Filenames[File]);
+				ToCheckOutPackages.Add(FilePackages[File]);
+			}
+			else if (Provider.UsesCheckout() && State->IsSourceControlled() && !State->IsCheckedOut() && !State->IsAdded())
+			{
+				Uneditable.Add(FilePackages[File]);
+				UE_LOG(LogTemp, Warning, TEXT("%s: Package can't be checked out (%s), its GUIDs are left unchanged."), *Filenames[File], *State->GetDisplayTooltip().ToString());
+			}
+		}
+
+		if (ToCheckOut.Num() > 0 && Provider.Execute(ISourceControlOperation::Create<FCheckOut>(), ToCheckOut) != ECommandResult::Succeeded)
+		{
+			// A batch can partially succeed, the cached states tell which files made it
+			Provider.GetState(ToCheckOut, States, EStateCacheUsage::Use);
+			StateFiles = MatchStates(ToCheckOut, States);
+			TBitArray<> IsCheckedOut(false, ToCheckOut.Num());
+			for (int32 Index = 0; Index < States.Num(); ++Index)
+			{
+				if (StateFiles[Index] != INDEX_NONE && States[Index]->IsCheckedOut())
+				{
+					IsCheckedOut[StateFiles[Index]] = true;
+				}
+			}
+			for (int32 File = 0; File < ToCheckOut.Num(); ++File)
+			{
+				if (!IsCheckedOut[File])
+				{
+					++NumFailed;
+					Uneditable.Add(ToCheckOutPackages[File]);
+					UE_LOG(LogTemp, Warning, TEXT("%s: Package failed to check out, its GUIDs are left unchanged."), *ToCheckOut[File]);
+				}
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Checked out %d of %d package(s) with %s in %.2fs."), ToCheckOut.Num() - NumFailed, PackageNames.Num(), *Provider.GetName().ToString(), FPlatformTime::Seconds() - StartTime);
+	}
+
+	// Without checkout, whether a file can be written is all that's left to check
+	IFileManager& FileManager = IFileManager::Get();
+	for (int32 File = 0; File < Filenames.Num(); ++File)
+	{
+		const FString& Filename = Filenames[File];
+		if (!Uneditable.Contains(FilePackages[File]) && FileManager.FileExists(*Filename) && FileManager.IsReadOnly(*Filename))
+		{
+			Uneditable.Add(FilePackages[File]);
+			UE_LOG(LogTemp, Warning, TEXT("%s: Package is read-only, its GUIDs are left unchanged."), *Filename);
+		}
+	}
+
+	return Uneditable;
+}
@@ -0,0 +1,16 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Makes the packages a fix is about to change editable with as few source control operations as possible */
+struct FGuidFixerSourceControl
+{
+	/**
+	 * Queries the state of every package in one request and checks out the ones that need it in one more.
+	 * Providers that don't use checkout, such as Git, only have their read-only files reported.
+	 * @return packages that are still not editable and must be left unchanged
+	 */
+	static TSet<FName> CheckOutPackages(const TSet<FName>& PackageNames);
+};
@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerTrackedGuid.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSourceData.h"
+#include "Engine/Level.h"
+#include "Engine/Texture.h"
+#include "Engine/World.h"
+#include "MeshDescription.h"
+#include "Materials/MaterialInterface.h"
+#include "Sound/SoundWave.h"
+#include "UObject/UObjectHash.h"
+
+/** @return the mesh description bulk data of a LOD, or null if it has none */
+static FMeshDescriptionBulkData* GetMeshDescriptionBulkData(const FStaticMeshSourceModel& SourceModel)
+{
+	UStaticMeshDescriptionBulkData* BulkData = SourceModel.StaticMeshDescriptionBulkData;
+	return BulkData && !BulkData->GetBulkData().IsEmpty() ? &BulkData->GetBulkData() : nullptr;
+}
+
+bool FGuidFixerTrackedGuids::IsTracked(const UObject* Object)
+{
+	return Object && (Object->IsA<UTexture>() || Object->IsA<UMaterialInterface>() || Object->IsA<USoundWave>() || Object->IsA<UStaticMesh>() || Object->IsA<UWorld>());
+}
+
+void FGuidFixerTrackedGuids::GetAll(const UObject* Object, TArray<FGuidFixerTrackedGuid>& OutGuids)
+{
+	if (const UTexture* Texture = Cast<UTexture>(Object))
+	{
+		OutGuids.Add({ EGuidFixerGuidKind::TextureLighting, ToCore(Texture->GetLightingGuid()) });
+		// Render targets and other generated textures have no source, and so no source ID
+		if (Texture->Source.IsValid())
+		{
+			OutGuids.Add({ EGuidFixerGuidKind::TextureSource, ToCore(Texture->Source.GetId()) });
+		}
+	}
+	else if (const UMaterialInterface* Material = Cast<UMaterialInterface>(Object))
+	{
+		// GetLightingGuid() has no const overload, but only reads here
+		OutGuids.Add({ EGuidFixerGuidKind::MaterialLighting, ToCore(const_cast<UMaterialInterface*>(Material)->GetLightingGuid()) });
+	}
+	else if (const USoundWave* SoundWave = Cast<USoundWave>(Object))
+	{
+		OutGuids.Add({ EGuidFixerGuidKind::SoundCompressedData, ToCore(SoundWave->CompressedDataGuid) });
+	}
+	else if (const UWorld* World = Cast<UWorld>(Object))
+	{
+		if (World->PersistentLevel)
+		{
+			OutGuids.Add({ EGuidFixerGuidKind::LevelBuildData, ToCore(World->PersistentLevel->LevelBuildDataId) });
+		}
+	}
+	else if (const UStaticMesh* StaticMesh = Cast<UStaticMesh>(Object))
+	{
+		for (int32 LODIndex = 0; LODIndex < StaticMesh->GetNumSourceModels(); ++LODIndex)
+		{
+			// IDs that are content hashes are suffixed with X, meshes only share those if their descriptions are identical
+			const FMeshDescriptionBulkData* BulkData = GetMeshDescriptionBulkData(StaticMesh->GetSourceModel(LODIndex));
+			const FString IdString = BulkData ? BulkData->GetIdString() : FString();
+			FGuid Guid;
+			if (!IdString.EndsWith(TEXT("X")) && FGuid::Parse(IdString, Guid))
+			{
+				OutGuids.Add({ EGuidFixerGuidKind::StaticMeshDescription, ToCore(Guid) });
+			}
+		}
+	}
+}
+
+bool FGuidFixerTrackedGuids::Regenerate(UObject* Object, EGuidFixerGuidKind Kind)
+{
+	switch (Kind)
+	{
+	case EGuidFixerGuidKind::TextureLighting:
+		if (UTexture* Texture = Cast<UTexture>(Object))
+		{
+			Texture->SetLightingGuid();
+			return true;
+		}
+		return false;
+	case EGuidFixerGuidKind::TextureSource:
+		if (UTexture* Texture = Cast<UTexture>(Object))
+		{
+			// Derived from the source content, so only textures that really are identical end up sharing an ID
+			Texture->Source.UseHashAsGuid();
+			return true;
+		}
+		return false;
+	case EGuidFixerGuidKind::StaticMeshDescription:
+		if (UStaticMesh* StaticMesh = Cast<UStaticMesh>(Object))
+		{
+			// Every LOD gets an ID derived from its description, which also takes it out of what is tracked
+			for (int32 LODIndex = 0; LODIndex < StaticMesh->GetNumSourceModels(); ++LODIndex)
+			{
+				if (FMeshDescriptionBulkData* BulkData = GetMeshDescriptionBulkData(StaticMesh->GetSourceModel(LODIndex)))
+				{
+					BulkData->UseHashAsGuid();
+				}
+			}
+			return true;
+		}
+		return false;
+	case EGuidFixerGuidKind::LevelBuildData:
+		if (UWorld* World = Cast<UWorld>(Object))
+		{
+			if (World->PersistentLevel)
+			{
+				// Build data stored under the old ID no longer applies, so the level needs its lighting rebuilt
+				World->PersistentLevel->Modify();
+				World->PersistentLevel->LevelBuildDataId = FGuid::NewGuid();
+				return true;
+			}
+		}
+		return false;
+	case EGuidFixerGuidKind::MaterialLighting:
+		if (UMaterialInterface* Material = Cast<UMaterialInterface>(Object))
+		{
+			Material->SetLightingGuid();
+			return true;
+		}
+		return false;
+	case EGuidFixerGuidKind::SoundCompressedData:
+		if (USoundWave* SoundWave = Cast<USoundWave>(Object))
+		{
+			// Also drops the compressed data cached under the old key, so it is rebuilt under the new one
+			SoundWave->InvalidateCompressedData(true);
+			return true;
+		}
+		return false;
+	default:
+		return false;
+	}
+}
+
+void FGuidFixerTrackedGuids::Get(const UObject* Object, TArray<FGuidFixerTrackedGuid>& OutGuids)
+{
+	const int32 FirstGuid = OutGuids.Num();
+	GetAll(Object, OutGuids);
+	for (int32 Index = OutGuids.Num() - 1; Index >= FirstGuid; --Index)
+	{
+		if (!OutGuids[Index].Guid.IsValid() || !MustBeUnique(OutGuids[Index].Kind))
+		{
+			OutGuids.RemoveAt(Index, 1, false);
+		}
+	}
+}
+
+void FGuidFixerTrackedGuids::GetForPackage(const UPackage* Package, TArray<FGuidFixerTrackedGuid>& OutGuids)
+{
+	ForEachObjectWithPackage(Package, [&OutGuids](UObject* Object)
+	{
+		Get(Object, OutGuids);
+		return true;
+	}, false);
+}
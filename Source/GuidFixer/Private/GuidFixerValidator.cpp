@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerValidator.h"
+#include "GuidFixer.h"
+#include "GuidFixerTrackedGuid.h"
+
+#define LOCTEXT_NAMESPACE "GuidFixerValidator"
+
+bool UGuidFixerValidator::CanValidateAsset_Implementation(UObject* InAsset) const
+{
+	if (!FGuidFixerTrackedGuids::IsTracked(InAsset))
+	{
+		return false;
+	}
+
+	if (!FGuidFixerModule::Get().GetIndex().IsOpen())
+	{
+		static bool bHasWarned = false;
+		if (!bHasWarned)
+		{
+			bHasWarned = true;
+			UE_LOG(LogTemp, Warning, TEXT("GUID collisions are not validated until the GUID index is built, build it with Tools -> GUID Fixer -> Rebuild GUID Index."));
+		}
+		return false;
+	}
+
+	return true;
+}
+
+EDataValidationResult UGuidFixerValidator::ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors)
+{
+	const FGuidFixerIndex& Index = FGuidFixerModule::Get().GetIndex();
+	const FName PackageName = InAsset->GetPackage()->GetFName();
+
+	TArray<FGuidFixerTrackedGuid> Guids;
+	FGuidFixerTrackedGuids::Get(InAsset, Guids);
+
+	bool bHasCollisions = false;
+	TArray<FGuidFixerIndexOwner> Owners;
+	for (const FGuidFixerTrackedGuid& Tracked : Guids)
+	{
+		Owners.Reset();
+		Index.Find(FGuidFixerTrackedGuids::ToEngine(Tracked.Guid), Owners);
+		for (const FGuidFixerIndexOwner& Owner : Owners)
+		{
+			// The same GUID under another kind identifies something else, so only owners of the same kind collide
+			if (Owner.PackageName != PackageName && Owner.Kind == Tracked.Kind)
+			{
+				bHasCollisions = true;
+				AssetFails(InAsset, FText::Format(LOCTEXT("GuidCollision", "{0} GUID {1} is also used by {2}. Fix it with Tools -> GUID Fixer."),
+					FText::FromString(FGuidFixerTrackedGuids::KindToString(Tracked.Kind)),
+					FText::FromString(FGuidFixerTrackedGuids::ToEngine(Tracked.Guid).ToString()),
+					FText::FromName(Owner.PackageName)), ValidationErrors);
+			}
+		}
+	}
+
+	if (!bHasCollisions)
+	{
+		AssetPasses(InAsset);
+	}
+	return GetValidationResult();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidatorBase.h"
+#include "GuidFixerValidator.generated.h"
+
+/**
+ * Fails materials and textures whose tracked GUIDs are owned by another package. Each asset costs a few GUID index lookups,
+ * so validating a changelist doesn't scan the project. Assets are skipped while there is no index, @see FGuidFixerIndex.
+ */
+UCLASS()
+class UGuidFixerValidator : public UEditorValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool CanValidateAsset_Implementation(UObject* InAsset) const override;
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors) override;
+};
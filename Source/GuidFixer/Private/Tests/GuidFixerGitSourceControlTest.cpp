@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerSourceControl.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "SourceControlHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GuidFixerGitSourceControlTest
+{
+	/** Runs git in WorkingDirectory, @return false if it couldn't be started or failed */
+	bool RunGit(const FString& WorkingDirectory, const FString& Params, FString* OutStdOut = nullptr)
+	{
+		int32 ReturnCode = -1;
+		FString StdOut;
+		FString StdErr;
+		const bool bStarted = FPlatformProcess::ExecProcess(TEXT("git"), *Params, &ReturnCode, &StdOut, &StdErr, *WorkingDirectory);
+		if (OutStdOut)
+		{
+			*OutStdOut = StdOut.TrimStartAndEnd();
+		}
+		return bStarted && ReturnCode == 0;
+	}
+}
+
+/**
+ * Runs CheckOutPackages against the Git provider, which doesn't use checkout, so only read-only files may be reported.
+ * The Git provider takes its repository root from the project directory and can't be pointed anywhere else, so the project
+ * has to be in a Git working tree. The packages are written under the automation transient directory of the project, which
+ * is usually ignored, so the one that has to be added is added with --force and removed from the index again afterwards.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGuidFixerGitSourceControlTest, "GuidFixer.SourceControl.GitReportsReadOnlyPackages", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGuidFixerGitSourceControlTest::RunTest(const FString& Parameters)
+{
+	using namespace GuidFixerGitSourceControlTest;
+
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	FString GitVersion;
+	if (!RunGit(ProjectDir, TEXT("--version"), &GitVersion))
+	{
+		AddError(TEXT("git could not be run, it has to be on the PATH for this test."));
+		return false;
+	}
+
+	FString RepositoryRoot;
+	if (!RunGit(ProjectDir, TEXT("rev-parse --show-toplevel"), &RepositoryRoot))
+	{
+		AddError(FString::Printf(TEXT("%s is not in a Git working tree. The Git provider finds its repository from the project directory, so the test project has to be in one."), *ProjectDir));
+		return false;
+	}
+
+	ISourceControlModule& SourceControlModule = ISourceControlModule::Get();
+	const FName PreviousProvider = SourceControlModule.GetProvider().GetName();
+	SourceControlModule.SetProvider(TEXT("Git"));
+	ISourceControlProvider& Provider = SourceControlModule.GetProvider();
+	Provider.Init(true);
+	if (Provider.GetName() != TEXT("Git") || !Provider.IsAvailable())
+	{
+		AddError(FString::Printf(TEXT("The Git source control provider is not available for %s, enable the GitSourceControl plugin."), *RepositoryRoot));
+		SourceControlModule.SetProvider(PreviousProvider);
+		return false;
+	}
+
+	const FString MountPoint = TEXT("/GuidFixerGitSourceControlTest/");
+	const FString ContentPath = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("GuidFixerGitSourceControlTest/"));
+	FPackageName::RegisterMountPoint(MountPoint, ContentPath);
+
+	const FName AddedPackage(*(MountPoint + TEXT("Added")));
+	const FName ReadOnlyPackage(*(MountPoint + TEXT("ReadOnly")));
+	const FName WritablePackage(*(MountPoint + TEXT("Writable")));
+	const TArray<FName> Packages = { AddedPackage, ReadOnlyPackage, WritablePackage };
+	TArray<FString> Filenames;
+	for (const FName PackageName : Packages)
+	{
+		Filenames.Add(SourceControlHelpers::PackageFilename(PackageName.ToString()));
+		TestTrue(FString::Printf(TEXT("%s written"), *PackageName.ToString()), FFileHelper::SaveStringToFile(FString(), *Filenames.Last()));
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TestTrue(TEXT("Package file added to Git"), RunGit(ContentPath, FString::Printf(TEXT("add --force -- \"%s\""), *Filenames[0])));
+	TestTrue(TEXT("Package file made read-only"), PlatformFile.SetReadOnly(*Filenames[1], true));
+
+	// The Git provider stamps states with local time
+	const FDateTime StartTime = FDateTime::Now();
+	const TSet<FName> Uneditable = FGuidFixerSourceControl::CheckOutPackages(TSet<FName>(Packages));
+	TestTrue(TEXT("Read-only package is reported"), Uneditable.Contains(ReadOnlyPackage));
+	TestFalse(TEXT("Added package is reported"), Uneditable.Contains(AddedPackage));
+	TestFalse(TEXT("Writable package is reported"), Uneditable.Contains(WritablePackage));
+	TestEqual(TEXT("Uneditable packages"), Uneditable.Num(), 1);
+
+	// The batched query has to have updated the cached state of every file, without another request being made here
+	TArray<FSourceControlStateRef> States;
+	TestTrue(TEXT("Cached state query"), Provider.GetState(Filenames, States, EStateCacheUsage::Use) == ECommandResult::Succeeded);
+	TestEqual(TEXT("Cached states"), States.Num(), Filenames.Num());
+	for (const FSourceControlStateRef& State : States)
+	{
+		TestTrue(FString::Printf(TEXT("%s: State updated by CheckOutPackages"), *State->GetFilename()), State->GetTimeStamp() >= StartTime);
+	}
+	if (States.Num() == Filenames.Num())
+	{
+		TestTrue(TEXT("Added package file is added"), States[0]->IsAdded());
+	}
+
+	RunGit(ContentPath, FString::Printf(TEXT("rm --cached --force --quiet -- \"%s\""), *Filenames[0]));
+	PlatformFile.SetReadOnly(*Filenames[1], false);
+	IFileManager::Get().DeleteDirectory(*ContentPath, false, true);
+	FPackageName::UnRegisterMountPoint(MountPoint, ContentPath);
+	SourceControlModule.SetProvider(PreviousProvider);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerCollisionDetector.h"
+#include "GuidFixerObjectSources.h"
+#include "GuidFixerPayloadGuard.h"
+#include "Engine/Texture.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Runs every scan the fixers start with and checks that none of them pulls a payload.
+ * Needs content virtualization to be enabled for the project, Config/Tests/GuidFixerVirtualizationTest.ini of the plugin
+ * sets it up with a FileSystem backend under the automation transient directory. Without it the test fails rather than
+ * passing without having asserted anything.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGuidFixerPayloadGuardTest, "GuidFixer.PayloadGuard.ScansPullNoPayloads", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGuidFixerPayloadGuardTest::RunTest(const FString& Parameters)
+{
+	if (FGuidFixerPayloadGuard::CanReadPayloads())
+	{
+		AddError(TEXT("Content virtualization is not enabled for this project, merge Config/Tests/GuidFixerVirtualizationTest.ini of the GuidFixer plugin into DefaultEngine.ini to run this test."));
+		return false;
+	}
+
+	FGuidFixerPayloadGuard PayloadGuard(TEXT("GuidFixerPayloadGuardTest"));
+	TestTrue(TEXT("Guard watches the virtualization system"), PayloadGuard.IsWatching());
+
+	FGuidFixerResolveOptions Options;
+	Options.bFixInvalid = true;
+	Options.bFixDuplicates = true;
+
+	{
+		FGuidFixerAssetRegistryObjectSource Source([](const FAssetData&) { return false; });
+		std::vector<FGuidFixerScanRecord> Records;
+		Source.ReadAll(Records);
+		FGuidFixerCollisionDetector::Resolve(Records, Options);
+	}
+	TestEqual(TEXT("Payloads pulled by the Asset Registry scan"), PayloadGuard.GetNumPulls(), 0);
+
+	{
+		// Texture source IDs are read from loaded textures, which must not hydrate their bulk data
+		FGuidFixerLoadedObjectSource Source(UTexture::StaticClass(), [](const UObject*) { return false; });
+		std::vector<FGuidFixerScanRecord> Records;
+		Source.ReadAll(Records);
+		FGuidFixerCollisionDetector::Resolve(Records, Options);
+	}
+	TestEqual(TEXT("Payloads pulled by the loaded texture scan"), PayloadGuard.GetNumPulls(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,52 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerSourceControl.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Without a provider that uses checkout, which includes source control being disabled, whether a package file can be
+ * written is all CheckOutPackages decides on. The packages live under a mount point of their own so no content is touched,
+ * and none of them is source controlled, so with a checkout provider the same is expected.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGuidFixerSourceControlTest, "GuidFixer.SourceControl.ReportsReadOnlyPackages", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGuidFixerSourceControlTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("Uneditable packages of an empty set"), FGuidFixerSourceControl::CheckOutPackages(TSet<FName>()).Num(), 0);
+
+	const FString MountPoint = TEXT("/GuidFixerSourceControlTest/");
+	const FString ContentPath = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("GuidFixerSourceControlTest/"));
+	FPackageName::RegisterMountPoint(MountPoint, ContentPath);
+
+	const FName ReadOnlyPackage(*(MountPoint + TEXT("ReadOnly")));
+	const FName WritablePackage(*(MountPoint + TEXT("Writable")));
+	const FName MissingPackage(*(MountPoint + TEXT("Missing")));
+	const FString ReadOnlyFilename = FPackageName::LongPackageNameToFilename(ReadOnlyPackage.ToString(), FPackageName::GetAssetPackageExtension());
+	const FString WritableFilename = FPackageName::LongPackageNameToFilename(WritablePackage.ToString(), FPackageName::GetAssetPackageExtension());
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TestTrue(TEXT("Read-only package file written"), FFileHelper::SaveStringToFile(FString(), *ReadOnlyFilename));
+	TestTrue(TEXT("Writable package file written"), FFileHelper::SaveStringToFile(FString(), *WritableFilename));
+	TestTrue(TEXT("Package file made read-only"), PlatformFile.SetReadOnly(*ReadOnlyFilename, true));
+
+	const TSet<FName> Uneditable = FGuidFixerSourceControl::CheckOutPackages({ ReadOnlyPackage, WritablePackage, MissingPackage });
+	TestTrue(TEXT("Read-only package is reported"), Uneditable.Contains(ReadOnlyPackage));
+	TestFalse(TEXT("Writable package is reported"), Uneditable.Contains(WritablePackage));
+	TestFalse(TEXT("Package without a file is reported"), Uneditable.Contains(MissingPackage));
+	TestEqual(TEXT("Uneditable packages"), Uneditable.Num(), 1);
+	TestFalse(TEXT("Writable package file is left writable"), PlatformFile.IsReadOnly(*WritableFilename));
+
+	PlatformFile.SetReadOnly(*ReadOnlyFilename, false);
+	IFileManager::Get().DeleteDirectory(*ContentPath, false, true);
+	FPackageName::UnRegisterMountPoint(MountPoint, ContentPath);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
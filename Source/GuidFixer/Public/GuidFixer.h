@@ -3,33 +3,135 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "Modules/ModuleManager.h"
+#include "GuidFixerCollisionDetector.h"
+#include "GuidFixerIndex.h"
 
 class FToolBarBuilder;
 class FMenuBuilder;
+struct FGuidFixerImpact;
+class FObjectPreSaveContext;
+class FObjectPostSaveContext;
+class FGuidFixerCookMonitor;
+class UCookOnTheFlyServer;
 
 class FGuidFixerModule : public IModuleInterface
 {
 public:
+	FGuidFixerModule();
+	// Defined out of line, where the types held by pointer below are complete
+	virtual ~FGuidFixerModule();
+
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
 
+	static FGuidFixerModule& Get()
+	{
+		return FModuleManager::LoadModuleChecked<FGuidFixerModule>(TEXT("GuidFixer"));
+	}
+
 	void FixMaterialGuids() const;
 	void FixTextureGuids() const;
 	void FixEmptyTextureGuids() const;
+	void FixSoundWaveGuids() const;
+	void FixStaticMeshGuids() const;
+	void FixGraphNodeGuids() const;
+	void FixLevelBuildDataIds() const;
+	void FindAssetRegistryCollisions() const;
+	void RebuildGuidIndex();
+
+	const FGuidFixerIndex& GetIndex() const { return Index; }
 
 private:
+	/** @return true if the object at PathName may have its GUIDs changed */
+	bool ShouldModifyPath(const FString& PathName) const;
+
 	template<typename T>
 	bool ShouldModify(T* Object) const;
+
+	/** @return true if Object may have its GUIDs changed and its package isn't one of UneditablePackages */
+	template<typename T>
+	bool CanModify(T* Object, const TSet<FName>& UneditablePackages) const;
+
+	/**
+	 * Scans the tracked GUIDs of every loaded T and decides which to regenerate, record N of the resolution is OutRecords[N] of OutObjects[N].
+	 * Objects in UneditablePackages are treated like ones that must not be modified.
+	 */
+	template<typename T>
+	FGuidFixerResolution ResolveGuids(const FGuidFixerResolveOptions& Options, const TSet<FName>& UneditablePackages, TArray<T*>& OutObjects, std::vector<FGuidFixerScanRecord>& OutRecords) const;
+
+	/**
+	 * Drops collisions of GUIDs that may be shared by identical content from Resolution when the content really is identical,
+	 * by hashing the source of the colliding textures. Record N of Resolution belongs to GetObject(N).
+	 */
+	void ExcludeSharedContent(FGuidFixerResolution& Resolution, const std::vector<FGuidFixerScanRecord>& Records, TFunctionRef<UObject*(uint32)> GetObject) const;
+
+	/** Regenerates the GUIDs Resolution asks for and logs what it can't resolve, @return true if anything was left unresolved */
+	template<typename T>
+	bool ApplyResolution(const FGuidFixerResolution& Resolution, const TArray<T*>& Objects, const std::vector<FGuidFixerScanRecord>& Records, const FGuidFixerResolveOptions& Options, const TSet<FName>& UneditablePackages, const TCHAR* ObjectType, TSet<FName>& OutModifiedPackages) const;
+
+	/** @return packages the fixers would change for objects of type T, without changing them */
+	template<typename T>
+	TSet<FName> FindPackagesToModify(const FGuidFixerResolveOptions& Options) const;
+
+	/**
+	 * Estimates what has to be rebuilt if PackageNames are changed and asks the user whether to go ahead.
+	 * Details are shown in the question too, which is then asked even if nothing has to be rebuilt.
+	 */
+	bool ConfirmImpact(const TSet<FName>& PackageNames, bool bAffectsLighting, bool bAffectsStreaming, FGuidFixerImpact& OutImpact, const FString& Details = FString()) const;
+
+	/** Rebuilds what a fix invalidated in the loaded levels and logs what that cost next to what was estimated */
+	void RebuildActualImpact(const FGuidFixerImpact& EstimatedImpact, const TSet<FName>& ModifiedPackages, bool bAffectsLighting, bool bAffectsStreaming, double StartTime) const;
+
+	/** Logs where each of a group of colliding objects was imported from, and how every pair of them relates */
+	void LogImportLineage(const TArray<const UObject*>& Objects) const;
+
+	/** Logs textures whose source data is byte-identical, @return number of duplicate groups found */
+	int32 FindDuplicateTextureSources() const;
 	
 	
 private:
 	void RegisterMenus();
 
+	void OnObjectModified(UObject* Object);
+	/** Checks the tracked GUIDs of a package against the index right before it is saved, @see GuidFixer.PreSaveCheck */
+	void OnPackagePreSave(UPackage* Package, FObjectPreSaveContext ObjectSaveContext);
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+	/** Writes the cook collision report once a cook has saved every package, and starts over for the next one */
+	void OnCookFinished(UCookOnTheFlyServer& CookOnTheFlyServer);
+	/** Regenerates the colliding GUIDs found while saving, on the tick after the save */
+	bool FixSavedGuids(float DeltaTime);
+
 
 private:
 	TSharedPtr<class FUICommandList> FixMaterialGuidsCommands;
 	TSharedPtr<class FUICommandList> FixTextureGuidsCommands;
 	TSharedPtr<class FUICommandList> FixEmptyTextureGuidsCommands;
+	TSharedPtr<class FUICommandList> FixSoundWaveGuidsCommands;
+	TSharedPtr<class FUICommandList> FixStaticMeshGuidsCommands;
+	TSharedPtr<class FUICommandList> FixGraphNodeGuidsCommands;
+	TSharedPtr<class FUICommandList> FixLevelBuildDataIdsCommands;
+	TSharedPtr<class FUICommandList> FindAssetRegistryCollisionsCommands;
+	TSharedPtr<class FUICommandList> RebuildGuidIndexCommands;
+
+	FGuidFixerIndex Index;
+
+	/** A colliding GUID found by the pre-save check, regenerated once its package has been saved */
+	struct FPendingGuidFix
+	{
+		TWeakObjectPtr<UObject> Object;
+		EGuidFixerGuidKind Kind;
+		FName CollidingPackage;
+	};
+
+	/** Fixes found by the pre-save check of packages that are still being saved */
+	TMap<FName, TArray<FPendingGuidFix>> PendingGuidFixes;
+	/** Fixes of packages that have been saved, waiting for the next tick */
+	TArray<FPendingGuidFix> SavedGuidFixes;
+	FTSTicker::FDelegateHandle FixSavedGuidsHandle;
+
+	/** Only has anything to report when packages are saved by a cook */
+	TUniquePtr<FGuidFixerCookMonitor> CookMonitor;
 };
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GuidFixerCoreTypes.h"
+
+struct FARFilter;
+struct FAssetData;
+
+/** Publishes tracked GUIDs as Asset Registry tags, so collisions can be found without loading anything */
+class FGuidFixerAssetTags
+{
+public:
+
+	static void Initialize();
+
+	static void Shutdown();
+
+	/** Tag holding the lighting GUID of materials, material instances and textures */
+	static const FName LightingGuidTag;
+
+	/** Tag holding the source ID of textures */
+	static const FName TextureSourceIdTag;
+
+	/** Tag holding the compressed data GUID of sound waves */
+	static const FName CompressedDataGuidTag;
+
+	/** Tag holding the mesh description bulk data IDs of every LOD of static meshes, except IDs that are content hashes */
+	static const FName MeshDescriptionIdsTag;
+
+	/** Tag holding the build data ID of the persistent level of maps */
+	static const FName LevelBuildDataIdTag;
+
+	/** Adds every class with tracked GUIDs to Filter */
+	static void AddTrackedClasses(FARFilter& Filter);
+
+	/** Appends the GUIDs tagged on Asset to OutGuids, including invalid ones, @return false if Asset has no GUID tag */
+	static bool GetTrackedGuids(const FAssetData& Asset, TArray<FGuidFixerTrackedGuid>& OutGuids);
+
+private:
+
+	static FName GetTag(EGuidFixerGuidKind Kind);
+
+	static void OnGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& InOutTags);
+
+private:
+
+	static FDelegateHandle OnGetExtraObjectTagsHandle;
+};
@@ -22,4 +22,10 @@ public:
 	TSharedPtr< FUICommandInfo > FixMaterialGuids;
 	TSharedPtr< FUICommandInfo > FixTextureGuids;
 	TSharedPtr< FUICommandInfo > FixEmptyTextureGuids;
+	TSharedPtr< FUICommandInfo > FixSoundWaveGuids;
+	TSharedPtr< FUICommandInfo > FixStaticMeshGuids;
+	TSharedPtr< FUICommandInfo > FixGraphNodeGuids;
+	TSharedPtr< FUICommandInfo > FixLevelBuildDataIds;
+	TSharedPtr< FUICommandInfo > FindAssetRegistryCollisions;
+	TSharedPtr< FUICommandInfo > RebuildGuidIndex;
 };
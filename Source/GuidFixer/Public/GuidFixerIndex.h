@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GuidFixerIndexReader.h"
+#include "GuidFixerTrackedGuid.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** One owner of a GUID found in the index */
+struct FGuidFixerIndexOwner
+{
+	FName PackageName;
+	EGuidFixerGuidKind Kind;
+};
+
+/**
+ * Persisted GUID index, layered so that it never has to be rewritten during a session.
+ *   Base:    read-only memory mapped hash table covering saved content when the index was last rebuilt
+ *   Saved:   packages saved since then, replayed from the append log on open
+ *   Session: packages with unsaved changes in this editor session
+ * A package present in a higher layer masks all of its entries in the lower ones, and every lookup is a constant number of hash probes.
+ * Base and Saved are read and written by GuidFixerCore, which guidfixer-query shares.
+ */
+class FGuidFixerIndex
+{
+public:
+
+	FGuidFixerIndex();
+
+	~FGuidFixerIndex();
+
+	static FString GetBaseFilename();
+
+	static FString GetLogFilename();
+
+	/** Maps the base file and replays the append log, @return false if there is no usable base file */
+	bool Open();
+
+	void Close();
+
+	bool IsOpen() const;
+
+	/**
+	 * Rebuilds the base from Asset Registry tags without loading anything, then truncates the log and reopens.
+	 * If the new base can't be written or moved into place, the previous one is kept open and false is returned.
+	 */
+	bool Rebuild();
+
+	/** Marks a package as having unsaved changes, its GUIDs are re-read lazily before the next lookup */
+	void MarkPackageDirty(const UPackage* Package);
+
+	/** Appends the current GUIDs of a package that has just been saved to the log and drops its session changes */
+	void CommitPackage(const UPackage* Package);
+
+	/** Appends every owner of Guid to OutOwners */
+	void Find(const FGuid& Guid, TArray<FGuidFixerIndexOwner>& OutOwners) const;
+
+private:
+
+	/** Packages and their GUIDs, with a reverse lookup from GUID to package */
+	struct FLayer
+	{
+		TMap<FName, TArray<FGuidFixerTrackedGuid>> Packages;
+		TMultiMap<FGuid, FName> Owners;
+
+		void SetPackage(FName PackageName, TArray<FGuidFixerTrackedGuid>&& Guids);
+		void RemovePackage(FName PackageName);
+		/** Appends the owners of Guid */
+		void Find(const FGuid& Guid, TArray<FGuidFixerIndexOwner>& OutOwners) const;
+	};
+
+	void FlushDirtyPackages() const;
+
+
+private:
+
+	TUniquePtr<IMappedFileHandle> BaseHandle;
+	TUniquePtr<IMappedFileRegion> BaseRegion;
+
+	/** Base and Saved layers */
+	FGuidFixerIndexReader Reader;
+
+	// Session changes are only ever read and written from the game thread, lookups fold in dirty packages on demand
+	mutable FLayer Session;
+	mutable TSet<FName> DirtyPackages;
+};
@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GuidFixerCoreTypes.h"
+
+/** Reads the GUIDs the plugin tracks from engine objects, as the engine independent types of GuidFixerCore */
+struct FGuidFixerTrackedGuids
+{
+	/** @return true if Object is of a type that has tracked GUIDs */
+	static bool IsTracked(const UObject* Object);
+
+	/** Appends every tracked GUID of Object to OutGuids, including invalid ones */
+	static void GetAll(const UObject* Object, TArray<FGuidFixerTrackedGuid>& OutGuids);
+
+	/** Gives Object a new GUID of the given kind, @return false if Object has no GUID of that kind */
+	static bool Regenerate(UObject* Object, EGuidFixerGuidKind Kind);
+
+	/** @return false for kinds that objects with identical content may legitimately share, those can only be checked with the content loaded */
+	static bool MustBeUnique(EGuidFixerGuidKind Kind)
+	{
+		return Kind != EGuidFixerGuidKind::TextureSource;
+	}
+
+	/** Appends the valid tracked GUIDs of Object that must be unique to OutGuids */
+	static void Get(const UObject* Object, TArray<FGuidFixerTrackedGuid>& OutGuids);
+
+	/** Appends the valid tracked GUIDs of every object in Package that must be unique to OutGuids */
+	static void GetForPackage(const UPackage* Package, TArray<FGuidFixerTrackedGuid>& OutGuids);
+
+	static FGuidFixerGuid ToCore(const FGuid& Guid)
+	{
+		return FGuidFixerGuid{ Guid.A, Guid.B, Guid.C, Guid.D };
+	}
+
+	static FGuid ToEngine(const FGuidFixerGuid& Guid)
+	{
+		return FGuid(Guid.A, Guid.B, Guid.C, Guid.D);
+	}
+
+	static FString KindToString(EGuidFixerGuidKind Kind)
+	{
+		return ANSI_TO_TCHAR(GuidFixerKindToString(Kind));
+	}
+};
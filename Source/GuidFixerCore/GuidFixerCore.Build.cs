@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Engine independent GUID scanning, resolving and index code. Only the module boilerplate uses the engine, the rest also builds
+// standalone with Source/GuidFixerCore/CMakeLists.txt.
+public class GuidFixerCore : ModuleRules
+{
+	public GuidFixerCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		CppStandard = CppStandardVersion.Cpp17;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+			);
+	}
+}
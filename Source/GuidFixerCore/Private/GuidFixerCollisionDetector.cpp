@@ -0,0 +1,165 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerCollisionDetector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+/** Sorts record indices by kind and GUID and appends a group for every pair of them that appears more than once */
+static void GroupRecords(const std::vector<FGuidFixerScanRecord>& Records, std::vector<uint32_t>& Indices, std::vector<FGuidFixerCollisionGroup>& OutGroups)
+{
+	const auto IsSameGroup = [&Records](uint32_t Lhs, uint32_t Rhs)
+	{
+		return Records[Lhs].Kind == Records[Rhs].Kind && Records[Lhs].Guid == Records[Rhs].Guid;
+	};
+
+	// Sorting record indices puts every group next to each other without hashing, ties keep scan order
+	std::sort(Indices.begin(), Indices.end(), [&Records](uint32_t Lhs, uint32_t Rhs)
+	{
+		const FGuidFixerScanRecord& LhsRecord = Records[Lhs];
+		const FGuidFixerScanRecord& RhsRecord = Records[Rhs];
+		if (LhsRecord.Kind != RhsRecord.Kind)
+		{
+			return LhsRecord.Kind < RhsRecord.Kind;
+		}
+		return LhsRecord.Guid < RhsRecord.Guid || (LhsRecord.Guid == RhsRecord.Guid && Lhs < Rhs);
+	});
+
+	for (size_t First = 0; First < Indices.size();)
+	{
+		size_t End = First + 1;
+		while (End < Indices.size() && IsSameGroup(Indices[End], Indices[First]))
+		{
+			++End;
+		}
+
+		if (End - First > 1)
+		{
+			FGuidFixerCollisionGroup Group;
+			Group.Kind = Records[Indices[First]].Kind;
+			Group.Guid = Records[Indices[First]].Guid;
+			Group.Records.assign(Indices.begin() + First, Indices.begin() + End);
+			const size_t NumFixed = size_t(std::count_if(Group.Records.begin(), Group.Records.end(), [&Records](uint32_t Record) { return !Records[Record].bModifiable; }));
+			Group.bResolvable = NumFixed <= 1;
+			OutGroups.push_back(std::move(Group));
+		}
+		First = End;
+	}
+}
+
+void FGuidFixerCollisionDetector::FindCollisions(const std::vector<FGuidFixerScanRecord>& Records, std::vector<FGuidFixerCollisionGroup>& OutGroups, uint32_t NumThreads)
+{
+	const size_t FirstGroup = OutGroups.size();
+	const uint32_t NumRecords = uint32_t(Records.size());
+
+	// Small scans finish before threads would have started
+	NumThreads = std::max(1u, std::min(NumThreads, NumRecords / 16384));
+	if (NumThreads == 1)
+	{
+		std::vector<uint32_t> Indices;
+		Indices.reserve(NumRecords);
+		for (uint32_t Record = 0; Record < NumRecords; ++Record)
+		{
+			if (Records[Record].Guid.IsValid())
+			{
+				Indices.push_back(Record);
+			}
+		}
+		GroupRecords(Records, Indices, OutGroups);
+	}
+	else
+	{
+		// Each thread splits a contiguous range of records into one partition per thread, every copy of a GUID lands in the same
+		// partition whatever its kind, and then each thread groups one partition. Ranges are in scan order, so partitions need
+		// no merging.
+		std::vector<std::vector<std::vector<uint32_t>>> RangePartitions(NumThreads, std::vector<std::vector<uint32_t>>(NumThreads));
+		std::vector<std::vector<FGuidFixerCollisionGroup>> PartitionGroups(NumThreads);
+		const auto RunOnThreads = [NumThreads](auto Work)
+		{
+			std::vector<std::thread> Threads;
+			Threads.reserve(NumThreads - 1);
+			for (uint32_t Thread = 1; Thread < NumThreads; ++Thread)
+			{
+				Threads.emplace_back(Work, Thread);
+			}
+			Work(0);
+			for (std::thread& Thread : Threads)
+			{
+				Thread.join();
+			}
+		};
+
+		RunOnThreads([&Records, &RangePartitions, NumThreads, NumRecords](uint32_t Thread)
+		{
+			std::vector<std::vector<uint32_t>>& Partitions = RangePartitions[Thread];
+			const uint32_t First = uint32_t(uint64_t(NumRecords) * Thread / NumThreads);
+			const uint32_t End = uint32_t(uint64_t(NumRecords) * (Thread + 1) / NumThreads);
+			for (std::vector<uint32_t>& Partition : Partitions)
+			{
+				Partition.reserve((End - First) / NumThreads + 1);
+			}
+			for (uint32_t Record = First; Record < End; ++Record)
+			{
+				if (Records[Record].Guid.IsValid())
+				{
+					Partitions[GuidFixerHashGuid(Records[Record].Guid) % NumThreads].push_back(Record);
+				}
+			}
+		});
+
+		RunOnThreads([&Records, &RangePartitions, &PartitionGroups, NumThreads](uint32_t Thread)
+		{
+			std::vector<uint32_t> Indices;
+			for (uint32_t Range = 0; Range < NumThreads; ++Range)
+			{
+				Indices.insert(Indices.end(), RangePartitions[Range][Thread].begin(), RangePartitions[Range][Thread].end());
+			}
+			GroupRecords(Records, Indices, PartitionGroups[Thread]);
+		});
+
+		for (std::vector<FGuidFixerCollisionGroup>& Groups : PartitionGroups)
+		{
+			std::move(Groups.begin(), Groups.end(), std::back_inserter(OutGroups));
+		}
+	}
+
+	std::sort(OutGroups.begin() + FirstGroup, OutGroups.end(), [](const FGuidFixerCollisionGroup& Lhs, const FGuidFixerCollisionGroup& Rhs)
+	{
+		return Lhs.Records.front() < Rhs.Records.front();
+	});
+}
+
+FGuidFixerResolution FGuidFixerCollisionDetector::Resolve(const std::vector<FGuidFixerScanRecord>& Records, const FGuidFixerResolveOptions& Options)
+{
+	FGuidFixerResolution Resolution;
+	for (uint32_t Record = 0; Record < Records.size(); ++Record)
+	{
+		if (!Records[Record].Guid.IsValid())
+		{
+			Resolution.InvalidRecords.push_back(Record);
+			if (Options.bFixInvalid && Records[Record].bModifiable)
+			{
+				Resolution.ToRegenerate.push_back(Record);
+			}
+		}
+	}
+
+	if (Options.bFixDuplicates)
+	{
+		FindCollisions(Records, Resolution.Collisions, Options.NumThreads);
+		for (const FGuidFixerCollisionGroup& Group : Resolution.Collisions)
+		{
+			for (const uint32_t Record : Group.Records)
+			{
+				if (Records[Record].bModifiable)
+				{
+					Resolution.ToRegenerate.push_back(Record);
+				}
+			}
+		}
+		std::sort(Resolution.ToRegenerate.begin(), Resolution.ToRegenerate.end());
+	}
+
+	return Resolution;
+}
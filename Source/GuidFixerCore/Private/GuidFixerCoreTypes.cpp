@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerCoreTypes.h"
+
+#include <cctype>
+#include <cstdio>
+
+std::string FGuidFixerGuid::ToString() const
+{
+	char Buffer[33];
+	std::snprintf(Buffer, sizeof(Buffer), "%08X%08X%08X%08X", A, B, C, D);
+	return Buffer;
+}
+
+bool FGuidFixerGuid::Parse(const std::string& Text, FGuidFixerGuid& OutGuid)
+{
+	uint32_t Parts[4] = {};
+	int NumDigits = 0;
+	for (const char Character : Text)
+	{
+		if (Character == '-' || Character == '{' || Character == '}')
+		{
+			continue;
+		}
+
+		const int Digit = std::isdigit(static_cast<unsigned char>(Character)) ? Character - '0'
+			: std::isxdigit(static_cast<unsigned char>(Character)) ? std::toupper(static_cast<unsigned char>(Character)) - 'A' + 10
+			: -1;
+		if (Digit < 0 || NumDigits == 32)
+		{
+			return false;
+		}
+
+		Parts[NumDigits / 8] = (Parts[NumDigits / 8] << 4) | uint32_t(Digit);
+		++NumDigits;
+	}
+
+	if (NumDigits != 32)
+	{
+		return false;
+	}
+
+	OutGuid = FGuidFixerGuid{ Parts[0], Parts[1], Parts[2], Parts[3] };
+	return true;
+}
+
+const char* GuidFixerKindToString(EGuidFixerGuidKind Kind)
+{
+	switch (Kind)
+	{
+	case EGuidFixerGuidKind::MaterialLighting:
+		return "MaterialLighting";
+	case EGuidFixerGuidKind::TextureLighting:
+		return "TextureLighting";
+	case EGuidFixerGuidKind::SoundCompressedData:
+		return "SoundCompressedData";
+	case EGuidFixerGuidKind::TextureSource:
+		return "TextureSource";
+	case EGuidFixerGuidKind::StaticMeshDescription:
+		return "StaticMeshDescription";
+	case EGuidFixerGuidKind::GraphNode:
+		return "GraphNode";
+	case EGuidFixerGuidKind::LevelBuildData:
+		return "LevelBuildData";
+	default:
+		return "Unknown";
+	}
+}
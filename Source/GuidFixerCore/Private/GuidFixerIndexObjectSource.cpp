@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerIndexObjectSource.h"
+
+FGuidFixerIndexObjectSource::FGuidFixerIndexObjectSource(const FGuidFixerIndexReader& InReader, std::function<bool(const std::string&)> InIsModifiable)
+	: Reader(InReader)
+	, IsModifiable(std::move(InIsModifiable))
+	, LogPackages(InReader.GetLogPackages())
+{
+}
+
+size_t FGuidFixerIndexObjectSource::NextBatch(std::vector<FGuidFixerScanRecord>& OutRecords, size_t MaxRecords)
+{
+	const uint64_t NumBasePackages = Reader.NumBasePackages();
+	const uint64_t NumPackages = NumBasePackages + LogPackages.size();
+
+	size_t NumAdded = 0;
+	while (NumAdded < MaxRecords)
+	{
+		// A package can own more GUIDs than fit in what is left of the batch, the rest are kept for the next one
+		if (NextPending == Pending.size())
+		{
+			if (NextPackage == NumPackages)
+			{
+				break;
+			}
+
+			Pending.clear();
+			NextPending = 0;
+			PendingPackage = NextPackage++;
+			if (PendingPackage < NumBasePackages)
+			{
+				Reader.FindBasePackage(uint32_t(PendingPackage), Pending);
+			}
+			else
+			{
+				Reader.FindPackage(LogPackages[PendingPackage - NumBasePackages], Pending);
+			}
+			continue;
+		}
+
+		const FGuidFixerIndexEntry& Entry = Pending[NextPending++];
+		OutRecords.push_back({ PendingPackage, Entry.Kind, Entry.Guid, IsModifiable(Entry.Package) });
+		++NumAdded;
+	}
+	return NumAdded;
+}
+
+std::string FGuidFixerIndexObjectSource::DescribeIdentity(uint64_t Identity) const
+{
+	const uint64_t NumBasePackages = Reader.NumBasePackages();
+	if (Identity < NumBasePackages)
+	{
+		return Reader.GetBasePackagePath(uint32_t(Identity));
+	}
+	return Identity - NumBasePackages < LogPackages.size() ? LogPackages[Identity - NumBasePackages] : std::string();
+}
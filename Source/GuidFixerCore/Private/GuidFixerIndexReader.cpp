@@ -0,0 +1,358 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerIndexReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+
+/** @return the first string greater than every string starting with Prefix, or an empty string if there is none */
+static std::string GetPrefixSuccessor(std::string Prefix)
+{
+	while (!Prefix.empty() && static_cast<unsigned char>(Prefix.back()) == 0xFF)
+	{
+		Prefix.pop_back();
+	}
+	if (!Prefix.empty())
+	{
+		Prefix.back() = char(static_cast<unsigned char>(Prefix.back()) + 1);
+	}
+	return Prefix;
+}
+
+bool FGuidFixerIndexReader::Initialize(const uint8_t* Data, uint64_t Size)
+{
+	Header = nullptr;
+	if (Data == nullptr || Size < sizeof(FGuidFixerIndexHeader))
+	{
+		return false;
+	}
+
+	// Every section has to lie within the file, checked so that corrupt offsets can't wrap around
+	const auto IsInFile = [Size](uint64_t Offset, uint64_t Bytes) { return Offset <= Size && Bytes <= Size - Offset; };
+	const FGuidFixerIndexHeader* MappedHeader = reinterpret_cast<const FGuidFixerIndexHeader*>(Data);
+	const bool bIsValid = MappedHeader->Magic == GUIDFIXER_INDEX_MAGIC
+		&& MappedHeader->Version == GUIDFIXER_INDEX_VERSION
+		&& MappedHeader->FileSize == Size
+		&& MappedHeader->NumSlots != 0 && (MappedHeader->NumSlots & (MappedHeader->NumSlots - 1)) == 0
+		&& uint64_t(MappedHeader->NumRecords) * 2 <= MappedHeader->NumSlots
+		&& MappedHeader->SlotsOffset >= sizeof(FGuidFixerIndexHeader)
+		&& IsInFile(MappedHeader->SlotsOffset, uint64_t(MappedHeader->NumSlots) * sizeof(FGuidFixerIndexSlot))
+		&& MappedHeader->SlotsOffset + uint64_t(MappedHeader->NumSlots) * sizeof(FGuidFixerIndexSlot) <= MappedHeader->PackageRecordsOffset
+		&& IsInFile(MappedHeader->PackageRecordsOffset, (uint64_t(MappedHeader->NumPaths) + 1 + MappedHeader->NumRecords) * sizeof(uint32_t))
+		&& MappedHeader->PackageRecordsOffset + (uint64_t(MappedHeader->NumPaths) + 1 + MappedHeader->NumRecords) * sizeof(uint32_t) <= MappedHeader->CollisionsOffset
+		&& IsInFile(MappedHeader->CollisionsOffset, uint64_t(MappedHeader->NumCollisionRecords) * sizeof(uint32_t))
+		&& MappedHeader->CollisionsOffset + uint64_t(MappedHeader->NumCollisionRecords) * sizeof(uint32_t) <= MappedHeader->KindCountsOffset
+		&& IsInFile(MappedHeader->KindCountsOffset, GUIDFIXER_INDEX_MAX_KINDS * sizeof(uint32_t))
+		&& MappedHeader->KindCountsOffset + GUIDFIXER_INDEX_MAX_KINDS * sizeof(uint32_t) <= MappedHeader->PathDictionaryOffset
+		&& IsInFile(MappedHeader->PathDictionaryOffset, MappedHeader->PathDictionarySize)
+		&& Paths.Initialize(Data + MappedHeader->PathDictionaryOffset, MappedHeader->PathDictionarySize)
+		&& Paths.Num() == MappedHeader->NumPaths;
+	if (!bIsValid)
+	{
+		return false;
+	}
+
+	Header = MappedHeader;
+	Slots = reinterpret_cast<const FGuidFixerIndexSlot*>(Data + Header->SlotsOffset);
+	FirstRecords = reinterpret_cast<const uint32_t*>(Data + Header->PackageRecordsOffset);
+	RecordSlots = FirstRecords + Header->NumPaths + 1;
+	Collisions = reinterpret_cast<const uint32_t*>(Data + Header->CollisionsOffset);
+	KindCounts = reinterpret_cast<const uint32_t*>(Data + Header->KindCountsOffset);
+	if (!AreTablesValid())
+	{
+		Header = nullptr;
+		return false;
+	}
+	return true;
+}
+
+bool FGuidFixerIndexReader::AreTablesValid() const
+{
+	// Lookups index with these values without checking them, so one pass over the tables makes sure none is out of range
+	uint32_t NumOccupied = 0;
+	for (uint32_t Slot = 0; Slot < Header->NumSlots; ++Slot)
+	{
+		if (!Slots[Slot].IsEmpty())
+		{
+			if (Slots[Slot].PathId >= Header->NumPaths)
+			{
+				return false;
+			}
+			++NumOccupied;
+		}
+	}
+
+	// With every record in a slot of its own and at most half of the slots taken, every probe sequence ends at an empty slot
+	if (NumOccupied != Header->NumRecords || FirstRecords[0] != 0 || FirstRecords[Header->NumPaths] > Header->NumRecords)
+	{
+		return false;
+	}
+	for (uint32_t PathId = 0; PathId < Header->NumPaths; ++PathId)
+	{
+		if (FirstRecords[PathId] > FirstRecords[PathId + 1])
+		{
+			return false;
+		}
+	}
+
+	const auto IsOccupiedSlot = [this](uint32_t Slot) { return Slot < Header->NumSlots && !Slots[Slot].IsEmpty(); };
+	return std::all_of(RecordSlots, RecordSlots + Header->NumRecords, IsOccupiedSlot)
+		&& std::all_of(Collisions, Collisions + Header->NumCollisionRecords, IsOccupiedSlot);
+}
+
+uint32_t FGuidFixerIndexReader::ReplayLog(const uint8_t* Data, uint64_t Size)
+{
+	uint64_t Offset = 0;
+	const auto Read = [Data, Size, &Offset](void* Out, uint64_t Bytes)
+	{
+		if (Size - Offset < Bytes)
+		{
+			return false;
+		}
+		std::memcpy(Out, Data + Offset, Bytes);
+		Offset += Bytes;
+		return true;
+	};
+
+	// A truncated trailing record means the editor went away while appending, everything before it is still good
+	uint32_t NumApplied = 0;
+	uint32_t RecordMagic = 0;
+	uint32_t PathBytes = 0;
+	while (Read(&RecordMagic, sizeof(RecordMagic)) && RecordMagic == GUIDFIXER_INDEX_LOG_RECORD_MAGIC && Read(&PathBytes, sizeof(PathBytes)) && Size - Offset >= PathBytes)
+	{
+		std::string Package(reinterpret_cast<const char*>(Data + Offset), PathBytes);
+		Offset += PathBytes;
+
+		uint32_t NumEntries = 0;
+		if (!Read(&NumEntries, sizeof(NumEntries)) || (Size - Offset) / (5 * sizeof(uint32_t)) < NumEntries)
+		{
+			break;
+		}
+
+		std::vector<FGuidFixerTrackedGuid> Guids(NumEntries);
+		for (FGuidFixerTrackedGuid& Tracked : Guids)
+		{
+			Read(&Tracked.Guid, sizeof(Tracked.Guid));
+			Read(&Tracked.Kind, sizeof(Tracked.Kind));
+		}
+		SetPackage(Package, std::move(Guids));
+		++NumApplied;
+	}
+	return NumApplied;
+}
+
+void FGuidFixerIndexReader::SetPackage(const std::string& Package, std::vector<FGuidFixerTrackedGuid> Guids)
+{
+	std::vector<FGuidFixerTrackedGuid>& Entries = LogPackages[Package];
+	for (const FGuidFixerTrackedGuid& Tracked : Entries)
+	{
+		EraseLogOwner(Tracked.Guid, Package);
+	}
+	Entries = std::move(Guids);
+	for (const FGuidFixerTrackedGuid& Tracked : Entries)
+	{
+		LogOwners.emplace(Tracked.Guid, Package);
+	}
+}
+
+bool FGuidFixerIndexReader::HasLogPackage(const std::string& Package) const
+{
+	return LogPackages.find(Package) != LogPackages.end();
+}
+
+void FGuidFixerIndexReader::FindOwners(const FGuidFixerGuid& Guid, std::vector<FGuidFixerIndexEntry>& OutEntries) const
+{
+	if (!Guid.IsValid())
+	{
+		return;
+	}
+
+	const auto Owners = LogOwners.equal_range(Guid);
+	for (auto It = Owners.first; It != Owners.second; ++It)
+	{
+		// A package can own the same GUID under more than one kind, report each of them once
+		if (std::find_if(Owners.first, It, [&It](const auto& Previous) { return Previous.second == It->second; }) != It)
+		{
+			continue;
+		}
+		for (const FGuidFixerTrackedGuid& Tracked : LogPackages.at(It->second))
+		{
+			if (Tracked.Guid == Guid)
+			{
+				OutEntries.push_back(FGuidFixerIndexEntry{ Guid, Tracked.Kind, It->second });
+			}
+		}
+	}
+
+	if (!IsValid())
+	{
+		return;
+	}
+
+	// Initialize made sure there is an empty slot, bounding the probes as well keeps a lookup finite whatever the data
+	const uint32_t Mask = Header->NumSlots - 1;
+	uint32_t Slot = GuidFixerHashGuid(Guid) & Mask;
+	for (uint32_t Probe = 0; Probe < Header->NumSlots && !Slots[Slot].IsEmpty(); ++Probe, Slot = (Slot + 1) & Mask)
+	{
+		if (Slots[Slot].GetGuid() == Guid)
+		{
+			AddBaseEntry(Slots[Slot], OutEntries);
+		}
+	}
+}
+
+void FGuidFixerIndexReader::FindPackage(const std::string& Package, std::vector<FGuidFixerIndexEntry>& OutEntries) const
+{
+	const auto LogPackage = LogPackages.find(Package);
+	if (LogPackage != LogPackages.end())
+	{
+		for (const FGuidFixerTrackedGuid& Tracked : LogPackage->second)
+		{
+			OutEntries.push_back(FGuidFixerIndexEntry{ Tracked.Guid, Tracked.Kind, Package });
+		}
+		return;
+	}
+
+	const int64_t PathId = IsValid() ? Paths.Find(Package) : -1;
+	if (PathId >= 0)
+	{
+		FindBasePackage(uint32_t(PathId), OutEntries);
+	}
+}
+
+void FGuidFixerIndexReader::FindCollisions(const std::string& Prefix, std::vector<FGuidFixerIndexEntry>& OutEntries) const
+{
+	std::set<std::pair<FGuidFixerGuid, EGuidFixerGuidKind>> Guids;
+	if (IsValid())
+	{
+		// Paths are sorted, so everything under the prefix is one contiguous range of path IDs and of the collision list
+		const std::string Successor = GetPrefixSuccessor(Prefix);
+		const uint32_t FirstPathId = Paths.LowerBound(Prefix);
+		const uint32_t EndPathId = Successor.empty() ? Paths.Num() : Paths.LowerBound(Successor);
+		const uint32_t* const CollisionsEnd = Collisions + Header->NumCollisionRecords;
+		const uint32_t* First = std::lower_bound(Collisions, CollisionsEnd, FirstPathId, [this](uint32_t Slot, uint32_t PathId) { return Slots[Slot].PathId < PathId; });
+		for (const uint32_t* It = First; It != CollisionsEnd && Slots[*It].PathId < EndPathId; ++It)
+		{
+			Guids.emplace(Slots[*It].GetGuid(), EGuidFixerGuidKind(Slots[*It].Kind));
+		}
+	}
+
+	// Saves since the base was built can both create and resolve collisions, those GUIDs are rechecked below
+	for (const auto& LogPackage : LogPackages)
+	{
+		if (LogPackage.first.compare(0, Prefix.size(), Prefix) == 0)
+		{
+			for (const FGuidFixerTrackedGuid& Tracked : LogPackage.second)
+			{
+				Guids.emplace(Tracked.Guid, Tracked.Kind);
+			}
+		}
+	}
+
+	// Owners of the same GUID under another kind don't collide with it, so they are left out
+	std::vector<FGuidFixerIndexEntry> Owners;
+	for (const std::pair<FGuidFixerGuid, EGuidFixerGuidKind>& Guid : Guids)
+	{
+		Owners.clear();
+		FindOwners(Guid.first, Owners);
+		Owners.erase(std::remove_if(Owners.begin(), Owners.end(), [&Guid](const FGuidFixerIndexEntry& Owner) { return Owner.Kind != Guid.second; }), Owners.end());
+		if (Owners.size() > 1)
+		{
+			OutEntries.insert(OutEntries.end(), Owners.begin(), Owners.end());
+		}
+	}
+}
+
+FGuidFixerIndexStats FGuidFixerIndexReader::GetStats() const
+{
+	FGuidFixerIndexStats Stats;
+	if (IsValid())
+	{
+		Stats.NumRecords = Header->NumRecords;
+		Stats.NumBaseRecords = Header->NumRecords;
+		Stats.NumPackages = Header->NumPaths;
+		Stats.NumSlots = Header->NumSlots;
+		Stats.NumCollisionRecords = Header->NumCollisionRecords;
+		Stats.PathDictionarySize = Header->PathDictionarySize;
+		std::copy(KindCounts, KindCounts + GUIDFIXER_INDEX_MAX_KINDS, Stats.KindCounts);
+	}
+
+	// A package in the log replaces its base records, so those are taken out and the log's entries counted instead
+	for (const auto& LogPackage : LogPackages)
+	{
+		const int64_t PathId = IsValid() ? Paths.Find(LogPackage.first) : -1;
+		if (PathId >= 0)
+		{
+			for (uint32_t Record = FirstRecords[PathId]; Record < FirstRecords[PathId + 1]; ++Record)
+			{
+				--Stats.NumRecords;
+				--Stats.KindCounts[std::min(Slots[RecordSlots[Record]].Kind, uint32_t(GUIDFIXER_INDEX_MAX_KINDS - 1))];
+			}
+		}
+		else
+		{
+			++Stats.NumPackages;
+		}
+
+		for (const FGuidFixerTrackedGuid& Tracked : LogPackage.second)
+		{
+			++Stats.NumRecords;
+			++Stats.KindCounts[std::min(uint32_t(Tracked.Kind), uint32_t(GUIDFIXER_INDEX_MAX_KINDS - 1))];
+		}
+	}
+	Stats.NumLogPackages = uint32_t(LogPackages.size());
+	return Stats;
+}
+
+std::string FGuidFixerIndexReader::GetBasePackagePath(uint32_t PathId) const
+{
+	return IsValid() ? Paths.GetPath(PathId) : std::string();
+}
+
+void FGuidFixerIndexReader::FindBasePackage(uint32_t PathId, std::vector<FGuidFixerIndexEntry>& OutEntries) const
+{
+	if (PathId >= NumBasePackages())
+	{
+		return;
+	}
+
+	for (uint32_t Record = FirstRecords[PathId]; Record < FirstRecords[PathId + 1]; ++Record)
+	{
+		AddBaseEntry(Slots[RecordSlots[Record]], OutEntries);
+	}
+}
+
+std::vector<std::string> FGuidFixerIndexReader::GetLogPackages() const
+{
+	std::vector<std::string> Packages;
+	Packages.reserve(LogPackages.size());
+	for (const auto& LogPackage : LogPackages)
+	{
+		Packages.push_back(LogPackage.first);
+	}
+	std::sort(Packages.begin(), Packages.end());
+	return Packages;
+}
+
+void FGuidFixerIndexReader::AddBaseEntry(const FGuidFixerIndexSlot& Slot, std::vector<FGuidFixerIndexEntry>& OutEntries) const
+{
+	std::string Package = Paths.GetPath(Slot.PathId);
+	if (!HasLogPackage(Package))
+	{
+		OutEntries.push_back(FGuidFixerIndexEntry{ Slot.GetGuid(), EGuidFixerGuidKind(Slot.Kind), std::move(Package) });
+	}
+}
+
+void FGuidFixerIndexReader::EraseLogOwner(const FGuidFixerGuid& Guid, const std::string& Package)
+{
+	const auto Owners = LogOwners.equal_range(Guid);
+	for (auto It = Owners.first; It != Owners.second; ++It)
+	{
+		if (It->second == Package)
+		{
+			LogOwners.erase(It);
+			return;
+		}
+	}
+}
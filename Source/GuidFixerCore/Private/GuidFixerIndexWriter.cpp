@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerIndexWriter.h"
+#include "GuidFixerIndexFormat.h"
+#include "GuidFixerPathDictionary.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+template<typename T>
+static void AppendBytes(std::vector<uint8_t>& Data, const T* Values, size_t Count)
+{
+	const uint8_t* Bytes = reinterpret_cast<const uint8_t*>(Values);
+	Data.insert(Data.end(), Bytes, Bytes + Count * sizeof(T));
+}
+
+std::vector<uint8_t> FGuidFixerIndexWriter::WriteBase(const std::vector<FGuidFixerIndexPackage>& Packages)
+{
+	std::vector<std::string> PackagePaths;
+	PackagePaths.reserve(Packages.size());
+	std::unordered_map<std::string, const FGuidFixerIndexPackage*> PackagesByPath;
+	PackagesByPath.reserve(Packages.size());
+	size_t NumRecords = 0;
+	for (const FGuidFixerIndexPackage& Package : Packages)
+	{
+		PackagePaths.push_back(Package.Path);
+		PackagesByPath.emplace(Package.Path, &Package);
+		NumRecords += Package.Guids.size();
+	}
+
+	// Path IDs are positions in the sorted dictionary, so they are only known once it is built
+	std::vector<uint8_t> Dictionary;
+	const std::vector<std::string> SortedPaths = FGuidFixerPathDictionary::Build(std::move(PackagePaths), Dictionary);
+
+	// Half full at most, so probe sequences stay short
+	uint32_t NumSlots = 16;
+	while (NumSlots < NumRecords * 2)
+	{
+		NumSlots *= 2;
+	}
+	const uint32_t Mask = NumSlots - 1;
+
+	std::vector<FGuidFixerIndexSlot> Table(NumSlots, FGuidFixerIndexSlot{});
+	std::vector<uint32_t> FirstRecords;
+	FirstRecords.reserve(SortedPaths.size() + 1);
+	std::vector<uint32_t> RecordSlots;
+	RecordSlots.reserve(NumRecords);
+	// A GUID only collides with records of its own kind, the same value under another kind identifies something else
+	std::unordered_map<FGuidFixerTrackedGuid, uint32_t, FGuidFixerTrackedGuidHash> GuidCounts;
+	GuidCounts.reserve(NumRecords);
+	uint32_t KindCounts[GUIDFIXER_INDEX_MAX_KINDS] = {};
+	for (uint32_t PathId = 0; PathId < SortedPaths.size(); ++PathId)
+	{
+		FirstRecords.push_back(uint32_t(RecordSlots.size()));
+		for (const FGuidFixerTrackedGuid& Tracked : PackagesByPath.at(SortedPaths[PathId])->Guids)
+		{
+			if (!Tracked.Guid.IsValid())
+			{
+				continue;
+			}
+
+			uint32_t Slot = GuidFixerHashGuid(Tracked.Guid) & Mask;
+			while (!Table[Slot].IsEmpty())
+			{
+				Slot = (Slot + 1) & Mask;
+			}
+			Table[Slot] = FGuidFixerIndexSlot{ Tracked.Guid.A, Tracked.Guid.B, Tracked.Guid.C, Tracked.Guid.D, PathId, uint32_t(Tracked.Kind) };
+			RecordSlots.push_back(Slot);
+			++GuidCounts[Tracked];
+			++KindCounts[std::min(uint32_t(Tracked.Kind), uint32_t(GUIDFIXER_INDEX_MAX_KINDS - 1))];
+		}
+	}
+	FirstRecords.push_back(uint32_t(RecordSlots.size()));
+
+	// Record slots are already in path order, so filtering them keeps the collisions sorted for prefix queries
+	std::vector<uint32_t> Collisions;
+	for (const uint32_t Slot : RecordSlots)
+	{
+		if (GuidCounts[FGuidFixerTrackedGuid{ EGuidFixerGuidKind(Table[Slot].Kind), Table[Slot].GetGuid() }] > 1)
+		{
+			Collisions.push_back(Slot);
+		}
+	}
+
+	FGuidFixerIndexHeader Header = {};
+	Header.Magic = GUIDFIXER_INDEX_MAGIC;
+	Header.Version = GUIDFIXER_INDEX_VERSION;
+	Header.NumRecords = uint32_t(RecordSlots.size());
+	Header.NumSlots = NumSlots;
+	Header.NumPaths = uint32_t(SortedPaths.size());
+	Header.NumCollisionRecords = uint32_t(Collisions.size());
+	Header.SlotsOffset = sizeof(FGuidFixerIndexHeader);
+	Header.PackageRecordsOffset = Header.SlotsOffset + Table.size() * sizeof(FGuidFixerIndexSlot);
+	Header.CollisionsOffset = Header.PackageRecordsOffset + (FirstRecords.size() + RecordSlots.size()) * sizeof(uint32_t);
+	Header.KindCountsOffset = Header.CollisionsOffset + Collisions.size() * sizeof(uint32_t);
+	Header.PathDictionaryOffset = Header.KindCountsOffset + sizeof(KindCounts);
+	Header.PathDictionarySize = Dictionary.size();
+	Header.FileSize = Header.PathDictionaryOffset + Header.PathDictionarySize;
+
+	std::vector<uint8_t> Data;
+	Data.reserve(Header.FileSize);
+	AppendBytes(Data, &Header, 1);
+	AppendBytes(Data, Table.data(), Table.size());
+	AppendBytes(Data, FirstRecords.data(), FirstRecords.size());
+	AppendBytes(Data, RecordSlots.data(), RecordSlots.size());
+	AppendBytes(Data, Collisions.data(), Collisions.size());
+	AppendBytes(Data, KindCounts, GUIDFIXER_INDEX_MAX_KINDS);
+	AppendBytes(Data, Dictionary.data(), Dictionary.size());
+	return Data;
+}
+
+void FGuidFixerIndexWriter::AppendLogRecord(const FGuidFixerIndexPackage& Package, std::vector<uint8_t>& OutData)
+{
+	const uint32_t RecordHeader[] = { GUIDFIXER_INDEX_LOG_RECORD_MAGIC, uint32_t(Package.Path.size()) };
+	AppendBytes(OutData, RecordHeader, 2);
+	AppendBytes(OutData, Package.Path.data(), Package.Path.size());
+
+	std::vector<uint32_t> Entries;
+	Entries.reserve(1 + Package.Guids.size() * 5);
+	Entries.push_back(0);
+	for (const FGuidFixerTrackedGuid& Tracked : Package.Guids)
+	{
+		if (Tracked.Guid.IsValid())
+		{
+			Entries.insert(Entries.end(), { Tracked.Guid.A, Tracked.Guid.B, Tracked.Guid.C, Tracked.Guid.D, uint32_t(Tracked.Kind) });
+		}
+	}
+	Entries[0] = uint32_t((Entries.size() - 1) / 5);
+	AppendBytes(OutData, Entries.data(), Entries.size());
+}
@@ -0,0 +1,10 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerObjectSource.h"
+
+void IGuidFixerObjectSource::ReadAll(std::vector<FGuidFixerScanRecord>& OutRecords, size_t BatchSize)
+{
+	while (NextBatch(OutRecords, BatchSize) > 0)
+	{
+	}
+}
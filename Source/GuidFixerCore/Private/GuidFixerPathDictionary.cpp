@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerPathDictionary.h"
+
+#include <algorithm>
+#include <cstring>
+
+static void WriteVarInt(std::vector<uint8_t>& Data, uint32_t Value)
+{
+	while (Value >= 0x80)
+	{
+		Data.push_back(uint8_t(Value) | 0x80);
+		Value >>= 7;
+	}
+	Data.push_back(uint8_t(Value));
+}
+
+static bool ReadVarInt(const uint8_t*& Cursor, const uint8_t* End, uint32_t& OutValue)
+{
+	OutValue = 0;
+	for (uint32_t Shift = 0; Shift < 35 && Cursor < End; Shift += 7)
+	{
+		const uint8_t Byte = *Cursor++;
+		OutValue |= uint32_t(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+template<typename T>
+static void AppendBytes(std::vector<uint8_t>& Data, const T* Values, size_t Count)
+{
+	const uint8_t* Bytes = reinterpret_cast<const uint8_t*>(Values);
+	Data.insert(Data.end(), Bytes, Bytes + Count * sizeof(T));
+}
+
+std::vector<std::string> FGuidFixerPathDictionary::Build(std::vector<std::string> Paths, std::vector<uint8_t>& OutData, uint32_t BlockSize)
+{
+	// std::string compares as unsigned bytes, so this is UTF-8 byte order and lookups can binary search on the stored bytes
+	std::sort(Paths.begin(), Paths.end());
+	Paths.erase(std::unique(Paths.begin(), Paths.end()), Paths.end());
+
+	std::vector<uint32_t> Offsets;
+	std::vector<uint8_t> Blocks;
+	for (size_t Index = 0; Index < Paths.size(); ++Index)
+	{
+		const std::string& Path = Paths[Index];
+		uint32_t Shared = 0;
+		if (Index % BlockSize == 0)
+		{
+			Offsets.push_back(uint32_t(Blocks.size()));
+		}
+		else
+		{
+			const std::string& Previous = Paths[Index - 1];
+			const size_t MaxShared = std::min(Previous.size(), Path.size());
+			while (Shared < MaxShared && Previous[Shared] == Path[Shared])
+			{
+				++Shared;
+			}
+		}
+
+		WriteVarInt(Blocks, Shared);
+		WriteVarInt(Blocks, uint32_t(Path.size() - Shared));
+		Blocks.insert(Blocks.end(), Path.begin() + Shared, Path.end());
+	}
+
+	FGuidFixerPathDictionaryHeader NewHeader;
+	NewHeader.NumPaths = uint32_t(Paths.size());
+	NewHeader.BlockSize = BlockSize;
+	NewHeader.NumBlocks = uint32_t(Offsets.size());
+	NewHeader.BlockDataSize = uint32_t(Blocks.size());
+
+	OutData.reserve(OutData.size() + sizeof(NewHeader) + Offsets.size() * sizeof(uint32_t) + Blocks.size());
+	AppendBytes(OutData, &NewHeader, 1);
+	AppendBytes(OutData, Offsets.data(), Offsets.size());
+	AppendBytes(OutData, Blocks.data(), Blocks.size());
+	return Paths;
+}
+
+bool FGuidFixerPathDictionary::Initialize(const uint8_t* InData, uint64_t InSize)
+{
+	Header = nullptr;
+	if (InSize < sizeof(FGuidFixerPathDictionaryHeader))
+	{
+		return false;
+	}
+
+	const FGuidFixerPathDictionaryHeader* NewHeader = reinterpret_cast<const FGuidFixerPathDictionaryHeader*>(InData);
+	const bool bIsValid = NewHeader->BlockSize > 0
+		&& NewHeader->NumBlocks == (uint64_t(NewHeader->NumPaths) + NewHeader->BlockSize - 1) / NewHeader->BlockSize
+		&& sizeof(FGuidFixerPathDictionaryHeader) + uint64_t(NewHeader->NumBlocks) * sizeof(uint32_t) + NewHeader->BlockDataSize <= InSize;
+	if (!bIsValid)
+	{
+		return false;
+	}
+
+	Header = NewHeader;
+	BlockOffsets = reinterpret_cast<const uint32_t*>(InData + sizeof(FGuidFixerPathDictionaryHeader));
+	BlockData = reinterpret_cast<const uint8_t*>(BlockOffsets + Header->NumBlocks);
+	return true;
+}
+
+template<typename CallbackType>
+bool FGuidFixerPathDictionary::DecodeBlock(uint32_t BlockIndex, std::string& OutPath, CallbackType Callback) const
+{
+	const uint32_t BlockOffset = BlockOffsets[BlockIndex];
+	if (BlockOffset > Header->BlockDataSize)
+	{
+		return false;
+	}
+
+	const uint8_t* Cursor = BlockData + BlockOffset;
+	const uint8_t* End = BlockData + Header->BlockDataSize;
+	const uint32_t NumInBlock = std::min(Header->BlockSize, Header->NumPaths - BlockIndex * Header->BlockSize);
+	OutPath.clear();
+	for (uint32_t Index = 0; Index < NumInBlock; ++Index)
+	{
+		uint32_t Shared = 0;
+		uint32_t Suffix = 0;
+		if (!ReadVarInt(Cursor, End, Shared) || !ReadVarInt(Cursor, End, Suffix) || Shared > OutPath.size() || Suffix > uint64_t(End - Cursor))
+		{
+			return false;
+		}
+
+		OutPath.resize(Shared);
+		OutPath.append(reinterpret_cast<const char*>(Cursor), Suffix);
+		Cursor += Suffix;
+		if (!Callback(Index))
+		{
+			break;
+		}
+	}
+	return true;
+}
+
+std::string FGuidFixerPathDictionary::GetPath(uint32_t PathId) const
+{
+	std::string Path;
+	if (!Header || PathId >= Header->NumPaths)
+	{
+		return Path;
+	}
+
+	const uint32_t IndexInBlock = PathId % Header->BlockSize;
+	if (!DecodeBlock(PathId / Header->BlockSize, Path, [IndexInBlock](uint32_t Index) { return Index < IndexInBlock; }))
+	{
+		Path.clear();
+	}
+	return Path;
+}
+
+uint32_t FGuidFixerPathDictionary::LowerBound(const std::string& Path) const
+{
+	if (!Header || Header->NumPaths == 0)
+	{
+		return 0;
+	}
+
+	// Binary search for the last block whose first path is not greater than Path, then scan that block
+	std::string Candidate;
+	uint32_t Low = 0;
+	uint32_t High = Header->NumBlocks;
+	while (High - Low > 1)
+	{
+		const uint32_t Middle = Low + (High - Low) / 2;
+		if (!DecodeBlock(Middle, Candidate, [](uint32_t) { return false; }))
+		{
+			return Header->NumPaths;
+		}
+
+		if (Candidate.compare(Path) <= 0)
+		{
+			Low = Middle;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+
+	uint32_t Result = Low * Header->BlockSize;
+	DecodeBlock(Low, Candidate, [&Candidate, &Path, &Result](uint32_t)
+	{
+		if (Candidate.compare(Path) < 0)
+		{
+			++Result;
+			return true;
+		}
+		return false;
+	});
+	return Result;
+}
+
+int64_t FGuidFixerPathDictionary::Find(const std::string& Path) const
+{
+	const uint32_t PathId = LowerBound(Path);
+	return PathId < Num() && GetPath(PathId) == Path ? int64_t(PathId) : -1;
+}
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerSyntheticObjectSource.h"
+
+#include <algorithm>
+
+FGuidFixerSyntheticObjectSource::FGuidFixerSyntheticObjectSource(const FGuidFixerSyntheticSourceParams& InParams)
+	: Params(InParams)
+	, Random(InParams.Seed)
+{
+}
+
+size_t FGuidFixerSyntheticObjectSource::NextBatch(std::vector<FGuidFixerScanRecord>& OutRecords, size_t MaxRecords)
+{
+	std::uniform_real_distribution<double> Chance(0.0, 1.0);
+	const size_t NumToAdd = size_t(std::min<uint64_t>(MaxRecords, Params.NumRecords - NextRecord));
+	for (size_t Index = 0; Index < NumToAdd; ++Index)
+	{
+		FGuidFixerScanRecord Record;
+		Record.Identity = NextRecord++;
+		Record.Kind = EGuidFixerGuidKind(Record.Identity % 2);
+		Record.bModifiable = Chance(Random) < Params.ModifiableRate;
+
+		// Invalid records keep the all zero GUID they start with
+		const double Roll = Chance(Random);
+		if (Roll < Params.InvalidRate)
+		{
+			OutRecords.push_back(Record);
+			continue;
+		}
+
+		if (Roll < Params.InvalidRate + Params.DuplicateRate && !Issued.empty())
+		{
+			Record.Guid = Issued[std::uniform_int_distribution<size_t>(0, Issued.size() - 1)(Random)];
+		}
+		else
+		{
+			do
+			{
+				const uint64_t High = Random();
+				const uint64_t Low = Random();
+				Record.Guid = FGuidFixerGuid{ uint32_t(High >> 32), uint32_t(High), uint32_t(Low >> 32), uint32_t(Low) };
+			}
+			while (!Record.Guid.IsValid());
+			Issued.push_back(Record.Guid);
+		}
+		OutRecords.push_back(Record);
+	}
+	return NumToAdd;
+}
+
+std::string FGuidFixerSyntheticObjectSource::DescribeIdentity(uint64_t Identity) const
+{
+	return "/Game/Synthetic/Object_" + std::to_string(Identity);
+}
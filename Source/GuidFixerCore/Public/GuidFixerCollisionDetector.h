@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GuidFixerCoreTypes.h"
+
+#include <vector>
+
+/** One scanned GUID, the detector identifies records by their position in the scan */
+struct FGuidFixerScanRecord
+{
+	/** Opaque to the detector, the object source that yielded the record resolves it, @see IGuidFixerObjectSource */
+	uint64_t Identity = 0;
+	EGuidFixerGuidKind Kind = EGuidFixerGuidKind::MaterialLighting;
+	FGuidFixerGuid Guid;
+	/** Whether the owner may be changed, @see FGuidFixerModule::ShouldModify() */
+	bool bModifiable = false;
+};
+
+struct FGuidFixerResolveOptions
+{
+	/** Regenerate invalid GUIDs of modifiable owners */
+	bool bFixInvalid = true;
+	/** Regenerate GUIDs that more than one record shares */
+	bool bFixDuplicates = true;
+	/** Threads to find collisions with, the result is the same for any number */
+	uint32_t NumThreads = 1;
+};
+
+/** Records of one kind sharing one valid GUID, the same GUID under different kinds identifies different things */
+struct FGuidFixerCollisionGroup
+{
+	EGuidFixerGuidKind Kind = EGuidFixerGuidKind::MaterialLighting;
+	FGuidFixerGuid Guid;
+	/** In scan order */
+	std::vector<uint32_t> Records;
+	/** False if more than one record of the group may not be modified, so the collision stays after fixing */
+	bool bResolvable = false;
+};
+
+struct FGuidFixerResolution
+{
+	/** Ordered by the first record of each group */
+	std::vector<FGuidFixerCollisionGroup> Collisions;
+	/** Records with an invalid GUID, in scan order */
+	std::vector<uint32_t> InvalidRecords;
+	/** Records whose GUID has to be regenerated, in scan order */
+	std::vector<uint32_t> ToRegenerate;
+};
+
+class GUIDFIXERCORE_API FGuidFixerCollisionDetector
+{
+public:
+
+	/**
+	 * Appends every group of records sharing a kind and a valid GUID to OutGroups, ordered by the first record of each group.
+	 * With more than one thread records are partitioned by GUID hash and each partition is grouped on a thread of its own.
+	 */
+	static void FindCollisions(const std::vector<FGuidFixerScanRecord>& Records, std::vector<FGuidFixerCollisionGroup>& OutGroups, uint32_t NumThreads = 1);
+
+	/**
+	 * Decides which GUIDs to regenerate. Every modifiable record of a collision group is regenerated, so the only GUIDs left
+	 * shared are those of records that may not be modified.
+	 */
+	static FGuidFixerResolution Resolve(const std::vector<FGuidFixerScanRecord>& Records, const FGuidFixerResolveOptions& Options);
+};
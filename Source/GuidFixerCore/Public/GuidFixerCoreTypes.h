@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// UnrealBuildTool defines this when the core is built as part of the plugin, standalone builds link it statically
+#ifndef GUIDFIXERCORE_API
+#define GUIDFIXERCORE_API
+#endif
+
+/** 128-bit GUID with the same layout as the engine's FGuid, an all zero GUID is invalid */
+struct FGuidFixerGuid
+{
+	uint32_t A = 0;
+	uint32_t B = 0;
+	uint32_t C = 0;
+	uint32_t D = 0;
+
+	bool IsValid() const
+	{
+		return (A | B | C | D) != 0;
+	}
+
+	bool operator==(const FGuidFixerGuid& Other) const
+	{
+		return A == Other.A && B == Other.B && C == Other.C && D == Other.D;
+	}
+
+	bool operator!=(const FGuidFixerGuid& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	bool operator<(const FGuidFixerGuid& Other) const
+	{
+		if (A != Other.A)
+		{
+			return A < Other.A;
+		}
+		if (B != Other.B)
+		{
+			return B < Other.B;
+		}
+		if (C != Other.C)
+		{
+			return C < Other.C;
+		}
+		return D < Other.D;
+	}
+
+	/** @return the GUID as 32 upper case hex digits, the same as FGuid::ToString() */
+	GUIDFIXERCORE_API std::string ToString() const;
+
+	/** Accepts 32 hex digits, optionally hyphenated and braced. @return false if Text isn't a GUID */
+	GUIDFIXERCORE_API static bool Parse(const std::string& Text, FGuidFixerGuid& OutGuid);
+};
+
+/** Hash used to place GUIDs in the persisted index, it is part of the file format so must stay stable */
+inline uint32_t GuidFixerHashGuid(const FGuidFixerGuid& Guid)
+{
+	uint64_t Hash = ((uint64_t(Guid.A) << 32) | Guid.B) * 0x9E3779B97F4A7C15ull ^ ((uint64_t(Guid.C) << 32) | Guid.D);
+	Hash ^= Hash >> 29;
+	Hash *= 0xBF58476D1CE4E5B9ull;
+	Hash ^= Hash >> 32;
+	return uint32_t(Hash);
+}
+
+struct FGuidFixerGuidHash
+{
+	size_t operator()(const FGuidFixerGuid& Guid) const
+	{
+		return GuidFixerHashGuid(Guid);
+	}
+};
+
+/** Kinds of GUIDs the plugin tracks, the values are stored in the GUID index so must never be reordered */
+enum class EGuidFixerGuidKind : uint32_t
+{
+	MaterialLighting = 0,
+	TextureLighting = 1,
+	/** Keys the compressed audio of a sound wave in the derived data cache */
+	SoundCompressedData = 2,
+	/** Keys the derived data of a texture, textures with identical source content may share one */
+	TextureSource = 3,
+	/** Keys the derived data built from a static mesh LOD's mesh description */
+	StaticMeshDescription = 4,
+	/** Identifies a node within its graph, only unique per graph so never stored in the GUID index */
+	GraphNode = 5,
+	/** Keys the built lighting and other build data of a level */
+	LevelBuildData = 6,
+};
+
+GUIDFIXERCORE_API const char* GuidFixerKindToString(EGuidFixerGuidKind Kind);
+
+/** A GUID the plugin tracks and what it identifies */
+struct FGuidFixerTrackedGuid
+{
+	EGuidFixerGuidKind Kind = EGuidFixerGuidKind::MaterialLighting;
+	FGuidFixerGuid Guid;
+
+	bool operator==(const FGuidFixerTrackedGuid& Other) const
+	{
+		return Kind == Other.Kind && Guid == Other.Guid;
+	}
+};
+
+struct FGuidFixerTrackedGuidHash
+{
+	size_t operator()(const FGuidFixerTrackedGuid& Tracked) const
+	{
+		return size_t(GuidFixerHashGuid(Tracked.Guid)) * 31 + uint32_t(Tracked.Kind);
+	}
+};
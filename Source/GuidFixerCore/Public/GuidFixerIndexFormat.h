@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GuidFixerCoreTypes.h"
+
+/**
+ * On-disk layout of the persisted GUID index, all values little endian.
+ *
+ * Base file (GuidIndex.bin), memory mapped read-only:
+ *   FGuidFixerIndexHeader
+ *   FGuidFixerIndexSlot[NumSlots]    open addressed hash table keyed by GUID, linear probing, an all zero GUID marks an empty slot
+ *   uint32[NumPaths + 1]             first entry of each path in the package records below
+ *   uint32[NumRecords]               slot indices grouped by path ID, so all GUIDs of a package are found without probing
+ *   uint32[NumCollisionRecords]      slot indices of every record whose GUID appears more than once, ordered by path ID
+ *   uint32[GUIDFIXER_INDEX_MAX_KINDS] number of records of each kind
+ *   path dictionary                  package paths front coded by FGuidFixerPathDictionary, slots refer to them by path ID
+ *
+ * Append log (GuidIndex.log), replayed on open and truncated whenever the base is rebuilt:
+ *   a sequence of records, each replacing every entry of one package
+ *   uint32 RecordMagic, uint32 PathBytes, UTF-8 path, uint32 NumEntries, NumEntries * { uint32 A, B, C, D, Kind }
+ */
+
+#define GUIDFIXER_INDEX_MAGIC 0x58494647 // 'GFIX'
+#define GUIDFIXER_INDEX_VERSION 3
+#define GUIDFIXER_INDEX_LOG_RECORD_MAGIC 0x474C4647 // 'GFLG'
+#define GUIDFIXER_INDEX_MAX_KINDS 16
+
+struct FGuidFixerIndexHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t NumRecords;
+	uint32_t NumSlots;
+	uint32_t NumPaths;
+	uint32_t NumCollisionRecords;
+	uint64_t SlotsOffset;
+	uint64_t PackageRecordsOffset;
+	uint64_t CollisionsOffset;
+	uint64_t KindCountsOffset;
+	uint64_t PathDictionaryOffset;
+	uint64_t PathDictionarySize;
+	uint64_t FileSize;
+};
+
+struct FGuidFixerIndexSlot
+{
+	uint32_t A;
+	uint32_t B;
+	uint32_t C;
+	uint32_t D;
+	uint32_t PathId;
+	uint32_t Kind;
+
+	bool IsEmpty() const
+	{
+		return (A | B | C | D) == 0;
+	}
+
+	FGuidFixerGuid GetGuid() const
+	{
+		return FGuidFixerGuid{ A, B, C, D };
+	}
+};
+
+static_assert(sizeof(FGuidFixerIndexHeader) == 80, "The index header is part of the file format");
+static_assert(sizeof(FGuidFixerIndexSlot) == 24, "Index slots are part of the file format");
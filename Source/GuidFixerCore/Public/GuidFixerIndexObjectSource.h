@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GuidFixerIndexReader.h"
+#include "GuidFixerObjectSource.h"
+
+#include <functional>
+
+/** Yields every GUID in a persisted index, base packages first and then those the log replaced. Identities are package IDs. */
+class GUIDFIXERCORE_API FGuidFixerIndexObjectSource : public IGuidFixerObjectSource
+{
+public:
+
+	/** IsModifiable decides the modifiable flag of a package's records from its path, the reader has to outlive the source */
+	FGuidFixerIndexObjectSource(const FGuidFixerIndexReader& InReader, std::function<bool(const std::string&)> InIsModifiable);
+
+	virtual size_t NextBatch(std::vector<FGuidFixerScanRecord>& OutRecords, size_t MaxRecords) override;
+	virtual std::string DescribeIdentity(uint64_t Identity) const override;
+	virtual const char* GetName() const override { return "Index"; }
+
+private:
+
+	const FGuidFixerIndexReader& Reader;
+	std::function<bool(const std::string&)> IsModifiable;
+	std::vector<std::string> LogPackages;
+
+	/** Next package to read, base path IDs followed by indices into LogPackages offset by the number of base packages */
+	uint64_t NextPackage = 0;
+	std::vector<FGuidFixerIndexEntry> Pending;
+	size_t NextPending = 0;
+	uint64_t PendingPackage = 0;
+};
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GuidFixerCoreTypes.h"
+#include "GuidFixerIndexFormat.h"
+#include "GuidFixerPathDictionary.h"
+
+#include <unordered_map>
+#include <vector>
+
+/** One owner of a GUID found in the index */
+struct FGuidFixerIndexEntry
+{
+	FGuidFixerGuid Guid;
+	EGuidFixerGuidKind Kind = EGuidFixerGuidKind::MaterialLighting;
+	/** UTF-8 package path */
+	std::string Package;
+};
+
+/** Counts of the index as it reads with the log laid over the base, unless noted otherwise */
+struct FGuidFixerIndexStats
+{
+	uint32_t NumRecords = 0;
+	uint32_t NumPackages = 0;
+	/** Records in the base hash table, including those the log masks, which still occupy their slots */
+	uint32_t NumBaseRecords = 0;
+	uint32_t NumSlots = 0;
+	/** Colliding records when the base was built */
+	uint32_t NumCollisionRecords = 0;
+	uint64_t PathDictionarySize = 0;
+	uint32_t KindCounts[GUIDFIXER_INDEX_MAX_KINDS] = {};
+	/** Packages replaced by the log since the base was built */
+	uint32_t NumLogPackages = 0;
+};
+
+/**
+ * Reads a base index file written by FGuidFixerIndexWriter, with the packages of its append log laid over it.
+ * The base is viewed in place, typically from a memory mapping, and has to outlive the reader. A package in the log masks all
+ * of its entries in the base, and every GUID lookup is a constant number of hash probes.
+ */
+class GUIDFIXERCORE_API FGuidFixerIndexReader
+{
+public:
+
+	/**
+	 * Views base file data, @return false if it is malformed or was written by a different format version.
+	 * Checks every table of the base once, so lookups can't read out of bounds or probe forever on a corrupt file.
+	 */
+	bool Initialize(const uint8_t* Data, uint64_t Size);
+
+	bool IsValid() const { return Header != nullptr; }
+
+	/** Applies every complete record of append log data, a truncated trailing record is ignored. @return the number of records applied */
+	uint32_t ReplayLog(const uint8_t* Data, uint64_t Size);
+
+	/** Replaces every entry of Package, as a log record for it would */
+	void SetPackage(const std::string& Package, std::vector<FGuidFixerTrackedGuid> Guids);
+
+	/** @return true if Package was replaced by the log, so its base entries are masked */
+	bool HasLogPackage(const std::string& Package) const;
+
+	/** Appends every owner of Guid to OutEntries */
+	void FindOwners(const FGuidFixerGuid& Guid, std::vector<FGuidFixerIndexEntry>& OutEntries) const;
+
+	/** Appends every GUID Package owns to OutEntries */
+	void FindPackage(const std::string& Package, std::vector<FGuidFixerIndexEntry>& OutEntries) const;
+
+	/** Appends every entry under the path Prefix whose GUID has more than one owner of the same kind, grouped by GUID and kind */
+	void FindCollisions(const std::string& Prefix, std::vector<FGuidFixerIndexEntry>& OutEntries) const;
+
+	FGuidFixerIndexStats GetStats() const;
+
+	/** @return the number of packages in the base, their path IDs are 0 to NumBasePackages() - 1 */
+	uint32_t NumBasePackages() const { return IsValid() ? Header->NumPaths : 0; }
+
+	std::string GetBasePackagePath(uint32_t PathId) const;
+
+	/** Appends every GUID the base package PathId owns to OutEntries, nothing if the log replaced the package */
+	void FindBasePackage(uint32_t PathId, std::vector<FGuidFixerIndexEntry>& OutEntries) const;
+
+	/** @return every package the log replaced, sorted */
+	std::vector<std::string> GetLogPackages() const;
+
+private:
+
+	/** @return true if every slot, path and record index of the viewed base is in range and the hash table has an empty slot */
+	bool AreTablesValid() const;
+
+	void AddBaseEntry(const FGuidFixerIndexSlot& Slot, std::vector<FGuidFixerIndexEntry>& OutEntries) const;
+
+	void EraseLogOwner(const FGuidFixerGuid& Guid, const std::string& Package);
+
+private:
+
+	const FGuidFixerIndexHeader* Header = nullptr;
+	const FGuidFixerIndexSlot* Slots = nullptr;
+	const uint32_t* FirstRecords = nullptr;
+	const uint32_t* RecordSlots = nullptr;
+	const uint32_t* Collisions = nullptr;
+	const uint32_t* KindCounts = nullptr;
+	FGuidFixerPathDictionary Paths;
+
+	std::unordered_map<std::string, std::vector<FGuidFixerTrackedGuid>> LogPackages;
+	std::unordered_multimap<FGuidFixerGuid, std::string, FGuidFixerGuidHash> LogOwners;
+};
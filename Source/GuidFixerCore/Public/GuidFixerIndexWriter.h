@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GuidFixerCoreTypes.h"
+
+#include <vector>
+
+/** All tracked GUIDs of one package, as written to the index */
+struct FGuidFixerIndexPackage
+{
+	/** UTF-8 package path, e.g. /Game/Env/T_Rock */
+	std::string Path;
+	std::vector<FGuidFixerTrackedGuid> Guids;
+};
+
+class GUIDFIXERCORE_API FGuidFixerIndexWriter
+{
+public:
+
+	/** @return the contents of a base index file holding Packages, @see GuidFixerIndexFormat.h */
+	static std::vector<uint8_t> WriteBase(const std::vector<FGuidFixerIndexPackage>& Packages);
+
+	/** Appends a log record that replaces every entry of Package to OutData */
+	static void AppendLogRecord(const FGuidFixerIndexPackage& Package, std::vector<uint8_t>& OutData);
+};
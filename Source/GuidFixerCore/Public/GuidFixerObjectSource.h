@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GuidFixerCollisionDetector.h"
+
+/**
+ * Something GUIDs are scanned from: loaded objects, Asset Registry tags, the persisted index or generated data. Sources yield
+ * records in batches so a scan never needs more than one batch of source specific state at a time, and so each source can be
+ * profiled on its own behind the same detection code.
+ */
+class GUIDFIXERCORE_API IGuidFixerObjectSource
+{
+public:
+
+	/** Records per batch when the caller doesn't say, large enough to amortize the virtual call and small enough to stay in cache */
+	static constexpr size_t DefaultBatchSize = 1024;
+
+	virtual ~IGuidFixerObjectSource() = default;
+
+	/** Appends up to MaxRecords records to OutRecords, @return the number appended, 0 once the source is exhausted */
+	virtual size_t NextBatch(std::vector<FGuidFixerScanRecord>& OutRecords, size_t MaxRecords) = 0;
+
+	/** @return a readable name for the Identity of a record this source yielded, such as an object or package path */
+	virtual std::string DescribeIdentity(uint64_t Identity) const = 0;
+
+	/** @return a short name of the source for logs and profiles */
+	virtual const char* GetName() const = 0;
+
+	/** Appends every remaining record to OutRecords */
+	void ReadAll(std::vector<FGuidFixerScanRecord>& OutRecords, size_t BatchSize = DefaultBatchSize);
+};
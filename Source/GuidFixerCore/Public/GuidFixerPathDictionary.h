@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GuidFixerCoreTypes.h"
+
+#include <vector>
+
+/**
+ * Front coded dictionary of package paths, addressed by 32-bit path IDs.
+ * Paths are sorted by their UTF-8 bytes and split into blocks of a fixed number of paths. The first path of a block is stored
+ * whole and every other one as the length of the prefix it shares with the previous path plus the remaining suffix. A table
+ * of block offsets gives random access, so looking up an ID decodes at most one block.
+ *
+ * Layout, all values little endian:
+ *   FGuidFixerPathDictionaryHeader
+ *   uint32[NumBlocks]                offset of each block from the start of the block data
+ *   block data                       per path: varint shared prefix length (always 0 for the first path of a block), varint suffix length, suffix bytes
+ */
+struct FGuidFixerPathDictionaryHeader
+{
+	uint32_t NumPaths;
+	uint32_t BlockSize;
+	uint32_t NumBlocks;
+	uint32_t BlockDataSize;
+};
+
+static_assert(sizeof(FGuidFixerPathDictionaryHeader) == 16, "The dictionary header is part of the file format");
+
+class GUIDFIXERCORE_API FGuidFixerPathDictionary
+{
+public:
+
+	/** Paths per block, larger blocks compress better but take longer to decode */
+	static constexpr uint32_t DefaultBlockSize = 16;
+
+	/**
+	 * Sorts and de-duplicates UTF-8 Paths and appends the dictionary for them to OutData.
+	 * @return the sorted paths, index N of which has path ID N
+	 */
+	static std::vector<std::string> Build(std::vector<std::string> Paths, std::vector<uint8_t>& OutData, uint32_t BlockSize = DefaultBlockSize);
+
+	/** Views dictionary data built by Build(), which has to outlive the view. @return false if the data is malformed */
+	bool Initialize(const uint8_t* InData, uint64_t InSize);
+
+	bool IsValid() const { return Header != nullptr; }
+
+	uint32_t Num() const { return Header ? Header->NumPaths : 0; }
+
+	/** @return the path with the given ID, or an empty string if it is out of range */
+	std::string GetPath(uint32_t PathId) const;
+
+	/** @return the ID of the first path that is not less than Path, Num() if there is none */
+	uint32_t LowerBound(const std::string& Path) const;
+
+	/** @return the ID of Path, or -1 if it isn't in the dictionary */
+	int64_t Find(const std::string& Path) const;
+
+private:
+
+	/** Decodes paths of a block into OutPath until Callback returns false, @return false if the block is malformed */
+	template<typename CallbackType>
+	bool DecodeBlock(uint32_t BlockIndex, std::string& OutPath, CallbackType Callback) const;
+
+private:
+
+	const FGuidFixerPathDictionaryHeader* Header = nullptr;
+	const uint32_t* BlockOffsets = nullptr;
+	const uint8_t* BlockData = nullptr;
+};
@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GuidFixerObjectSource.h"
+
+#include <random>
+
+struct FGuidFixerSyntheticSourceParams
+{
+	uint64_t NumRecords = 100000;
+	/** Fraction of records that reuse the GUID of an earlier record */
+	double DuplicateRate = 0.001;
+	/** Fraction of records with an all zero GUID */
+	double InvalidRate = 0.0;
+	/** Fraction of records that may be modified */
+	double ModifiableRate = 0.9;
+	uint64_t Seed = 1;
+};
+
+/** Yields deterministic random records for benchmarks and stress tests, identities are record numbers */
+class GUIDFIXERCORE_API FGuidFixerSyntheticObjectSource : public IGuidFixerObjectSource
+{
+public:
+
+	explicit FGuidFixerSyntheticObjectSource(const FGuidFixerSyntheticSourceParams& InParams);
+
+	virtual size_t NextBatch(std::vector<FGuidFixerScanRecord>& OutRecords, size_t MaxRecords) override;
+	virtual std::string DescribeIdentity(uint64_t Identity) const override;
+	virtual const char* GetName() const override { return "Synthetic"; }
+
+private:
+
+	FGuidFixerSyntheticSourceParams Params;
+	std::mt19937_64 Random;
+	uint64_t NextRecord = 0;
+	/** GUIDs handed out so far that later records can duplicate */
+	std::vector<FGuidFixerGuid> Issued;
+};
@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerRuntime.h"
+#include "Engine/Texture.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY(LogGuidFixerRuntime);
+
+#if WITH_GUIDFIXER_RUNTIME_MONITOR
+static bool GGuidFixerRuntimeMonitorEnabled = true;
+static FAutoConsoleVariableRef CVarGuidFixerRuntimeMonitorEnabled(
+	TEXT("GuidFixer.RuntimeMonitor"),
+	GGuidFixerRuntimeMonitorEnabled,
+	TEXT("When enabled, texture lighting GUIDs are tracked on asset load and collisions are reported to the log."));
+#endif
+
+void FGuidFixerRuntimeModule::StartupModule()
+{
+#if WITH_GUIDFIXER_RUNTIME_MONITOR
+	// Reserve up front so the first few thousand loads never pay for a rehash
+	TextureGuids.Reserve(8192);
+
+	OnAssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FGuidFixerRuntimeModule::OnAssetLoaded);
+#endif
+}
+
+void FGuidFixerRuntimeModule::ShutdownModule()
+{
+#if WITH_GUIDFIXER_RUNTIME_MONITOR
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(OnAssetLoadedHandle);
+	TextureGuids.Empty();
+#endif
+}
+
+#if WITH_GUIDFIXER_RUNTIME_MONITOR
+void FGuidFixerRuntimeModule::OnAssetLoaded(UObject* Object)
+{
+	// Only textures are tracked here, material lighting GUIDs are editor-only data and don't exist in cooked builds
+	const UTexture* Texture = Cast<UTexture>(Object);
+	if (!GGuidFixerRuntimeMonitorEnabled || !Texture)
+	{
+		return;
+	}
+
+	const FGuid LightingGuid = Texture->GetLightingGuid();
+	if (!LightingGuid.IsValid())
+	{
+		return;
+	}
+
+	// The same package can be loaded again after being garbage collected, which is not a collision
+	// Load notifications can come from async loading threads, the map is sharded so they rarely wait on each other
+	const FName PackageName = Texture->GetPackage()->GetFName();
+	FName ExistingPackageName;
+	if (!TextureGuids.FindOrAdd(LightingGuid, PackageName, ExistingPackageName) && ExistingPackageName != PackageName)
+	{
+		UE_LOG(LogGuidFixerRuntime, Warning, TEXT("%s: Texture has conflicting GUID %s with %s. Texture streaming data may be wrong, run Tools -> GUID Fixer -> Fix Texture GUIDs in the editor."),
+			*Texture->GetPathName(), *LightingGuid.ToString(), *ExistingPackageName.ToString());
+	}
+}
+#endif
+
+IMPLEMENT_MODULE(FGuidFixerRuntimeModule, GuidFixerRuntime)
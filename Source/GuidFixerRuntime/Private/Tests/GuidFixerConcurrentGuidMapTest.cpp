@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GuidFixerConcurrentGuidMap.h"
+#include "Async/Async.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GuidFixerConcurrentGuidMapTest
+{
+	/**
+	 * Has every worker race to add the same GUIDs, each starting at a different offset so adds and lookups overlap.
+	 * Every GUID must have exactly one winner, and every loser must be handed the winner's value.
+	 */
+	template<uint32 NumShards>
+	void RunFindOrAddRace(FAutomationTestBase& Test, const TCHAR* Name)
+	{
+		constexpr int32 NumWorkers = 8;
+		constexpr int32 NumGuids = 20000;
+
+		TArray<FGuid> Guids;
+		Guids.Reserve(NumGuids);
+		for (int32 Index = 0; Index < NumGuids; ++Index)
+		{
+			Guids.Add(FGuid::NewGuid());
+		}
+
+		TGuidFixerConcurrentGuidMap<int32, NumShards> Map;
+		TArray<TArray<int32>> Wins;
+		TArray<TArray<int32>> ExistingValues;
+		Wins.SetNum(NumWorkers);
+		ExistingValues.SetNum(NumWorkers);
+
+		// Workers spin until all of them are running, otherwise the first one can be done before the last is started
+		TAtomic<int32> NumReady(0);
+		TArray<TFuture<void>> Workers;
+		for (int32 Worker = 0; Worker < NumWorkers; ++Worker)
+		{
+			Workers.Add(Async(EAsyncExecution::Thread, [&, Worker]()
+			{
+				ExistingValues[Worker].Init(INDEX_NONE, NumGuids);
+				++NumReady;
+				while (NumReady.Load() < NumWorkers)
+				{
+					FPlatformProcess::Yield();
+				}
+
+				for (int32 Step = 0; Step < NumGuids; ++Step)
+				{
+					const int32 Index = (Step + Worker * (NumGuids / NumWorkers)) % NumGuids;
+					int32 Existing = INDEX_NONE;
+					if (Map.FindOrAdd(Guids[Index], Worker, Existing))
+					{
+						Wins[Worker].Add(Index);
+					}
+					else
+					{
+						ExistingValues[Worker][Index] = Existing;
+					}
+				}
+			}));
+		}
+
+		for (TFuture<void>& Future : Workers)
+		{
+			Future.Wait();
+		}
+
+		TArray<int32> Winners;
+		Winners.Init(INDEX_NONE, NumGuids);
+		int32 NumExtraWinners = 0;
+		for (int32 Worker = 0; Worker < NumWorkers; ++Worker)
+		{
+			for (const int32 Index : Wins[Worker])
+			{
+				if (Winners[Index] != INDEX_NONE)
+				{
+					++NumExtraWinners;
+				}
+				Winners[Index] = Worker;
+			}
+		}
+
+		int32 NumWithoutWinner = 0;
+		int32 NumWrongValues = 0;
+		for (int32 Index = 0; Index < NumGuids; ++Index)
+		{
+			if (Winners[Index] == INDEX_NONE)
+			{
+				++NumWithoutWinner;
+				continue;
+			}
+
+			int32 Value = INDEX_NONE;
+			if (!Map.Find(Guids[Index], Value) || Value != Winners[Index])
+			{
+				++NumWrongValues;
+			}
+			for (int32 Worker = 0; Worker < NumWorkers; ++Worker)
+			{
+				if (Worker != Winners[Index] && ExistingValues[Worker][Index] != Winners[Index])
+				{
+					++NumWrongValues;
+				}
+			}
+		}
+
+		Test.TestEqual(FString::Printf(TEXT("%s: GUIDs added more than once"), Name), NumExtraWinners, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: GUIDs never added"), Name), NumWithoutWinner, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: Values not matching the winner"), Name), NumWrongValues, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: Number of entries"), Name), Map.Num(), NumGuids);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGuidFixerConcurrentGuidMapTest, "GuidFixer.ConcurrentGuidMap.FindOrAddHasOneWinner", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGuidFixerConcurrentGuidMapTest::RunTest(const FString& Parameters)
+{
+	// A single shard puts every worker on the same lock, the default spreads them out like the editor does
+	GuidFixerConcurrentGuidMapTest::RunFindOrAddRace<1>(*this, TEXT("One shard"));
+	GuidFixerConcurrentGuidMapTest::RunFindOrAddRace<64>(*this, TEXT("Default shards"));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+/**
+ * GUID keyed map that can be used from several threads at once, e.g. from asset load notifications on async loading threads.
+ * Keys are spread over independently locked shards, so threads only contend when they hit the same shard.
+ * Values are copied in and out under the shard lock, which means nothing handed out can be freed from under a reader.
+ */
+template<typename ValueType, uint32 NumShards = 64>
+class TGuidFixerConcurrentGuidMap
+{
+	static_assert(NumShards > 0 && NumShards <= 256 && (NumShards & (NumShards - 1)) == 0, "NumShards must be a power of two no larger than 256");
+
+public:
+
+	void Reserve(int32 Number)
+	{
+		for (FShard& Shard : Shards)
+		{
+			FRWScopeLock Lock(Shard.Lock, SLT_Write);
+			Shard.Map.Reserve(Number / NumShards + 1);
+		}
+	}
+
+	/**
+	 * Adds Value for Guid unless the GUID is already present.
+	 * @return true if added, otherwise false with the value already in the map copied to OutExisting
+	 */
+	bool FindOrAdd(const FGuid& Guid, const ValueType& Value, ValueType& OutExisting)
+	{
+		const uint32 Hash = GetTypeHash(Guid);
+		FShard& Shard = GetShard(Hash);
+
+		// Most lookups find the GUID already present or absent without needing to write, so try with a read lock first
+		{
+			FRWScopeLock Lock(Shard.Lock, SLT_ReadOnly);
+			if (const ValueType* Existing = Shard.Map.FindByHash(Hash, Guid))
+			{
+				OutExisting = *Existing;
+				return false;
+			}
+		}
+
+		FRWScopeLock Lock(Shard.Lock, SLT_Write);
+		if (const ValueType* Existing = Shard.Map.FindByHash(Hash, Guid))
+		{
+			OutExisting = *Existing;
+			return false;
+		}
+		Shard.Map.AddByHash(Hash, Guid, Value);
+		return true;
+	}
+
+	/** @return true if Guid is present, with its value copied to OutValue */
+	bool Find(const FGuid& Guid, ValueType& OutValue) const
+	{
+		const uint32 Hash = GetTypeHash(Guid);
+		const FShard& Shard = GetShard(Hash);
+
+		FRWScopeLock Lock(Shard.Lock, SLT_ReadOnly);
+		if (const ValueType* Existing = Shard.Map.FindByHash(Hash, Guid))
+		{
+			OutValue = *Existing;
+			return true;
+		}
+		return false;
+	}
+
+	bool Contains(const FGuid& Guid) const
+	{
+		const uint32 Hash = GetTypeHash(Guid);
+		const FShard& Shard = GetShard(Hash);
+
+		FRWScopeLock Lock(Shard.Lock, SLT_ReadOnly);
+		return Shard.Map.ContainsByHash(Hash, Guid);
+	}
+
+	/** @return true if Guid was present and has been removed */
+	bool Remove(const FGuid& Guid)
+	{
+		const uint32 Hash = GetTypeHash(Guid);
+		FShard& Shard = GetShard(Hash);
+
+		FRWScopeLock Lock(Shard.Lock, SLT_Write);
+		return Shard.Map.RemoveByHash(Hash, Guid) > 0;
+	}
+
+	/** Only exact when no other thread is writing */
+	int32 Num() const
+	{
+		int32 Number = 0;
+		for (const FShard& Shard : Shards)
+		{
+			FRWScopeLock Lock(Shard.Lock, SLT_ReadOnly);
+			Number += Shard.Map.Num();
+		}
+		return Number;
+	}
+
+	void Empty()
+	{
+		for (FShard& Shard : Shards)
+		{
+			FRWScopeLock Lock(Shard.Lock, SLT_Write);
+			Shard.Map.Empty();
+		}
+	}
+
+private:
+
+	// Padded to a cache line so locking one shard doesn't invalidate its neighbours
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		mutable FRWLock Lock;
+		TMap<FGuid, ValueType> Map;
+	};
+
+	// The maps bucket on the low bits of the hash, so the shard is picked from the top byte to keep buckets evenly used
+	FShard& GetShard(uint32 Hash)
+	{
+		return Shards[(Hash >> 24) & (NumShards - 1)];
+	}
+
+	const FShard& GetShard(uint32 Hash) const
+	{
+		return Shards[(Hash >> 24) & (NumShards - 1)];
+	}
+
+private:
+
+	FShard Shards[NumShards];
+};
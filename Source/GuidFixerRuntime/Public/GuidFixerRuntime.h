@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "GuidFixerConcurrentGuidMap.h"
+
+// The monitor only exists to catch collisions in development builds, so shipping builds compile it out entirely
+#define WITH_GUIDFIXER_RUNTIME_MONITOR (!UE_BUILD_SHIPPING)
+
+DECLARE_LOG_CATEGORY_EXTERN(LogGuidFixerRuntime, Log, All);
+
+class FGuidFixerRuntimeModule : public IModuleInterface
+{
+public:
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+#if WITH_GUIDFIXER_RUNTIME_MONITOR
+private:
+	void OnAssetLoaded(UObject* Object);
+
+
+private:
+	/** Texture lighting GUIDs seen so far, mapped to the package that owns them */
+	TGuidFixerConcurrentGuidMap<FName> TextureGuids;
+
+	FDelegateHandle OnAssetLoadedHandle;
+#endif
+};
@@ -0,0 +1,243 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// Microbenchmarks for GuidFixerCore. Run with --benchmark_format=json (or --benchmark_out=<file> --benchmark_out_format=json)
+// to keep results for comparison, and --benchmark_filter=<regex> to run a subset.
+
+#include "GuidFixerCollisionDetector.h"
+#include "GuidFixerIndexObjectSource.h"
+#include "GuidFixerIndexReader.h"
+#include "GuidFixerIndexWriter.h"
+#include "GuidFixerPathDictionary.h"
+#include "GuidFixerSyntheticObjectSource.h"
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+std::vector<FGuidFixerScanRecord> MakeRecords(int64_t NumRecords, double DuplicateRate = 0.001)
+{
+	FGuidFixerSyntheticSourceParams Params;
+	Params.NumRecords = uint64_t(NumRecords);
+	Params.DuplicateRate = DuplicateRate;
+	FGuidFixerSyntheticObjectSource Source(Params);
+
+	std::vector<FGuidFixerScanRecord> Records;
+	Records.reserve(size_t(NumRecords));
+	Source.ReadAll(Records);
+	return Records;
+}
+
+/** One package per record, with paths shaped like a project's content folders */
+std::vector<FGuidFixerIndexPackage> MakePackages(int64_t NumPackages)
+{
+	const std::vector<FGuidFixerScanRecord> Records = MakeRecords(NumPackages);
+	std::vector<FGuidFixerIndexPackage> Packages(Records.size());
+	for (size_t Index = 0; Index < Records.size(); ++Index)
+	{
+		Packages[Index].Path = "/Game/Environment/Zone" + std::to_string(Index % 97) + "/Props/T_Prop_" + std::to_string(Index);
+		Packages[Index].Guids.push_back({ Records[Index].Kind, Records[Index].Guid });
+	}
+	return Packages;
+}
+
+/** Base index data shared by the benchmarks of one size, built once because writing it is benchmarked separately */
+struct FIndexFixture
+{
+	std::vector<FGuidFixerIndexPackage> Packages;
+	std::vector<uint8_t> Data;
+	FGuidFixerIndexReader Reader;
+
+	static const FIndexFixture& Get(int64_t NumPackages)
+	{
+		static std::mutex Mutex;
+		static std::map<int64_t, std::unique_ptr<FIndexFixture>> Fixtures;
+
+		const std::lock_guard<std::mutex> Lock(Mutex);
+		std::unique_ptr<FIndexFixture>& Fixture = Fixtures[NumPackages];
+		if (!Fixture)
+		{
+			Fixture = std::make_unique<FIndexFixture>();
+			Fixture->Packages = MakePackages(NumPackages);
+			Fixture->Data = FGuidFixerIndexWriter::WriteBase(Fixture->Packages);
+			Fixture->Reader.Initialize(Fixture->Data.data(), Fixture->Data.size());
+		}
+		return *Fixture;
+	}
+};
+}
+
+static void BM_HashGuid(benchmark::State& State)
+{
+	const std::vector<FGuidFixerScanRecord> Records = MakeRecords(State.range(0));
+	for (auto _ : State)
+	{
+		uint32_t Hash = 0;
+		for (const FGuidFixerScanRecord& Record : Records)
+		{
+			Hash ^= GuidFixerHashGuid(Record.Guid);
+		}
+		benchmark::DoNotOptimize(Hash);
+	}
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_HashGuid)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+static void BM_SyntheticSource(benchmark::State& State)
+{
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(MakeRecords(State.range(0)));
+	}
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_SyntheticSource)->RangeMultiplier(16)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+static void BM_FindCollisions(benchmark::State& State)
+{
+	const std::vector<FGuidFixerScanRecord> Records = MakeRecords(State.range(0), State.range(1) / 1000.0);
+	for (auto _ : State)
+	{
+		std::vector<FGuidFixerCollisionGroup> Groups;
+		FGuidFixerCollisionDetector::FindCollisions(Records, Groups);
+		benchmark::DoNotOptimize(Groups.data());
+	}
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+// Second argument is the duplicate rate in permille
+BENCHMARK(BM_FindCollisions)->ArgsProduct({ { 1 << 10, 1 << 14, 1 << 18, 1 << 22 }, { 1, 100 } })->Unit(benchmark::kMicrosecond);
+
+static void BM_Resolve(benchmark::State& State)
+{
+	const std::vector<FGuidFixerScanRecord> Records = MakeRecords(State.range(0));
+	const FGuidFixerResolveOptions Options;
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(FGuidFixerCollisionDetector::Resolve(Records, Options));
+	}
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_Resolve)->RangeMultiplier(16)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_PathDictionaryBuild(benchmark::State& State)
+{
+	const FIndexFixture& Fixture = FIndexFixture::Get(State.range(0));
+	std::vector<std::string> Paths;
+	for (const FGuidFixerIndexPackage& Package : Fixture.Packages)
+	{
+		Paths.push_back(Package.Path);
+	}
+
+	for (auto _ : State)
+	{
+		std::vector<uint8_t> Data;
+		benchmark::DoNotOptimize(FGuidFixerPathDictionary::Build(Paths, Data));
+	}
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_PathDictionaryBuild)->RangeMultiplier(16)->Range(1 << 10, 1 << 18)->Unit(benchmark::kMicrosecond);
+
+static void BM_IndexWrite(benchmark::State& State)
+{
+	const FIndexFixture& Fixture = FIndexFixture::Get(State.range(0));
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(FGuidFixerIndexWriter::WriteBase(Fixture.Packages));
+	}
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_IndexWrite)->RangeMultiplier(16)->Range(1 << 10, 1 << 18)->Unit(benchmark::kMicrosecond);
+
+static void BM_IndexOpen(benchmark::State& State)
+{
+	// What guidfixer-query and the editor do on open once the file is mapped: validation and dictionary setup
+	const FIndexFixture& Fixture = FIndexFixture::Get(State.range(0));
+	for (auto _ : State)
+	{
+		FGuidFixerIndexReader Reader;
+		benchmark::DoNotOptimize(Reader.Initialize(Fixture.Data.data(), Fixture.Data.size()));
+	}
+}
+BENCHMARK(BM_IndexOpen)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+static void BM_IndexFindOwners(benchmark::State& State)
+{
+	const FIndexFixture& Fixture = FIndexFixture::Get(State.range(0));
+	std::vector<FGuidFixerIndexEntry> Entries;
+	size_t Next = size_t(State.thread_index()) * 7919;
+	for (auto _ : State)
+	{
+		Entries.clear();
+		Fixture.Reader.FindOwners(Fixture.Packages[Next++ % Fixture.Packages.size()].Guids[0].Guid, Entries);
+		benchmark::DoNotOptimize(Entries.data());
+	}
+	State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_IndexFindOwners)->RangeMultiplier(16)->Range(1 << 10, 1 << 18)->ThreadRange(1, 8);
+
+static void BM_IndexFindPackage(benchmark::State& State)
+{
+	const FIndexFixture& Fixture = FIndexFixture::Get(State.range(0));
+	std::vector<FGuidFixerIndexEntry> Entries;
+	size_t Next = size_t(State.thread_index()) * 7919;
+	for (auto _ : State)
+	{
+		Entries.clear();
+		Fixture.Reader.FindPackage(Fixture.Packages[Next++ % Fixture.Packages.size()].Path, Entries);
+		benchmark::DoNotOptimize(Entries.data());
+	}
+	State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_IndexFindPackage)->RangeMultiplier(16)->Range(1 << 10, 1 << 18)->ThreadRange(1, 8);
+
+static void BM_IndexFindCollisions(benchmark::State& State)
+{
+	const FIndexFixture& Fixture = FIndexFixture::Get(State.range(0));
+	std::vector<FGuidFixerIndexEntry> Entries;
+	for (auto _ : State)
+	{
+		Entries.clear();
+		Fixture.Reader.FindCollisions("/Game/Environment/Zone1", Entries);
+		benchmark::DoNotOptimize(Entries.data());
+	}
+}
+BENCHMARK(BM_IndexFindCollisions)->RangeMultiplier(16)->Range(1 << 10, 1 << 18)->Unit(benchmark::kMicrosecond);
+
+static void BM_IndexReplayLog(benchmark::State& State)
+{
+	// Every package saved once since the base was built, the worst case before the next rebuild
+	const FIndexFixture& Fixture = FIndexFixture::Get(State.range(0));
+	std::vector<uint8_t> Log;
+	for (const FGuidFixerIndexPackage& Package : Fixture.Packages)
+	{
+		FGuidFixerIndexWriter::AppendLogRecord(Package, Log);
+	}
+
+	for (auto _ : State)
+	{
+		FGuidFixerIndexReader Reader;
+		Reader.Initialize(Fixture.Data.data(), Fixture.Data.size());
+		benchmark::DoNotOptimize(Reader.ReplayLog(Log.data(), Log.size()));
+	}
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_IndexReplayLog)->RangeMultiplier(16)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMicrosecond);
+
+static void BM_IndexScan(benchmark::State& State)
+{
+	const FIndexFixture& Fixture = FIndexFixture::Get(State.range(0));
+	for (auto _ : State)
+	{
+		FGuidFixerIndexObjectSource Source(Fixture.Reader, [](const std::string& Path) { return Path.compare(0, 6, "/Game/") == 0; });
+		std::vector<FGuidFixerScanRecord> Records;
+		Source.ReadAll(Records);
+		benchmark::DoNotOptimize(Records.data());
+	}
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_IndexScan)->RangeMultiplier(16)->Range(1 << 10, 1 << 18)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// guidfixer-query answers questions about the persisted GUID index written by the GuidFixer editor module, without booting the editor.
+// The index is read with the same GuidFixerCore code the editor uses, see Source/GuidFixerCore/Public/GuidFixerIndexFormat.h.
+
+#include "GuidFixerIndexReader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+class FMappedFile
+{
+public:
+	~FMappedFile()
+	{
+#if defined(_WIN32)
+		if (Data)
+		{
+			UnmapViewOfFile(Data);
+		}
+		if (Mapping)
+		{
+			CloseHandle(Mapping);
+		}
+		if (File != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(File);
+		}
+#else
+		if (Data)
+		{
+			munmap(const_cast<uint8_t*>(Data), Size);
+		}
+#endif
+	}
+
+	bool Open(const std::string& Filename)
+	{
+#if defined(_WIN32)
+		File = CreateFileA(Filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		LARGE_INTEGER FileSize;
+		if (File == INVALID_HANDLE_VALUE || !GetFileSizeEx(File, &FileSize) || FileSize.QuadPart == 0)
+		{
+			return false;
+		}
+		Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		Data = Mapping ? static_cast<const uint8_t*>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+		Size = uint64_t(FileSize.QuadPart);
+#else
+		const int Descriptor = open(Filename.c_str(), O_RDONLY);
+		struct stat Stat;
+		if (Descriptor < 0 || fstat(Descriptor, &Stat) != 0 || Stat.st_size == 0)
+		{
+			if (Descriptor >= 0)
+			{
+				close(Descriptor);
+			}
+			return false;
+		}
+		void* Mapped = mmap(nullptr, size_t(Stat.st_size), PROT_READ, MAP_SHARED, Descriptor, 0);
+		close(Descriptor);
+		Data = Mapped == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(Mapped);
+		Size = uint64_t(Stat.st_size);
+#endif
+		return Data != nullptr;
+	}
+
+	const uint8_t* GetData() const { return Data; }
+	uint64_t GetSize() const { return Size; }
+
+private:
+	const uint8_t* Data = nullptr;
+	uint64_t Size = 0;
+#if defined(_WIN32)
+	HANDLE File = INVALID_HANDLE_VALUE;
+	HANDLE Mapping = nullptr;
+#endif
+};
+
+void PrintEntries(const std::vector<FGuidFixerIndexEntry>& Entries)
+{
+	for (const FGuidFixerIndexEntry& Entry : Entries)
+	{
+		std::printf("%s %-21s %s\n", Entry.Guid.ToString().c_str(), GuidFixerKindToString(Entry.Kind), Entry.Package.c_str());
+	}
+}
+
+void PrintStats(const FGuidFixerIndexStats& Stats)
+{
+	std::printf("Records:           %u\n", Stats.NumRecords);
+	std::printf("Packages:          %u\n", Stats.NumPackages);
+	std::printf("Colliding records: %u (when built)\n", Stats.NumCollisionRecords);
+	std::printf("Load factor:       %.2f (%u of %u slots)\n", Stats.NumSlots > 0 ? double(Stats.NumBaseRecords) / Stats.NumSlots : 0.0, Stats.NumBaseRecords, Stats.NumSlots);
+	std::printf("Path bytes:        %llu\n", static_cast<unsigned long long>(Stats.PathDictionarySize));
+	for (uint32_t Kind = 0; Kind < GUIDFIXER_INDEX_MAX_KINDS; ++Kind)
+	{
+		if (Stats.KindCounts[Kind] > 0)
+		{
+			std::printf("  %-21s%u\n", GuidFixerKindToString(EGuidFixerGuidKind(Kind)), Stats.KindCounts[Kind]);
+		}
+	}
+	std::printf("Saved since build: %u package(s)\n", Stats.NumLogPackages);
+}
+
+int PrintUsage()
+{
+	std::fprintf(stderr,
+		"Usage: guidfixer-query [--time] <Saved/GuidFixer directory or GuidIndex.bin> <query>\n"
+		"Queries:\n"
+		"  owner <guid>               packages owning a GUID\n"
+		"  collisions [path prefix]   GUIDs owned more than once, optionally only under a path such as /Game/Env\n"
+		"  package <package path>     GUIDs owned by a package such as /Game/Env/T_Rock\n"
+		"  stats                      record counts by kind\n");
+	return 2;
+}
+}
+
+int main(int ArgC, char** ArgV)
+{
+	std::vector<std::string> Args(ArgV + 1, ArgV + ArgC);
+	bool bPrintTime = false;
+	if (!Args.empty() && Args[0] == "--time")
+	{
+		bPrintTime = true;
+		Args.erase(Args.begin());
+	}
+
+	if (Args.size() < 2)
+	{
+		return PrintUsage();
+	}
+
+	// The editor keeps the log next to the base, so a directory or the base file both work
+	std::string BaseFilename = Args[0];
+	if (BaseFilename.size() < 4 || BaseFilename.compare(BaseFilename.size() - 4, 4, ".bin") != 0)
+	{
+		BaseFilename += "/GuidIndex.bin";
+	}
+	const std::string LogFilename = BaseFilename.substr(0, BaseFilename.size() - 4) + ".log";
+
+	const auto StartTime = std::chrono::steady_clock::now();
+
+	FMappedFile BaseFile;
+	if (!BaseFile.Open(BaseFilename))
+	{
+		std::fprintf(stderr, "%s: could not open GUID index\n", BaseFilename.c_str());
+		return 1;
+	}
+
+	FGuidFixerIndexReader Index;
+	if (!Index.Initialize(BaseFile.GetData(), BaseFile.GetSize()))
+	{
+		std::fprintf(stderr, "%s: GUID index is out of date or corrupt, rebuild it from the editor\n", BaseFilename.c_str());
+		return 1;
+	}
+
+	std::ifstream LogStream(LogFilename, std::ios::binary);
+	const std::vector<char> LogData((std::istreambuf_iterator<char>(LogStream)), std::istreambuf_iterator<char>());
+	Index.ReplayLog(reinterpret_cast<const uint8_t*>(LogData.data()), LogData.size());
+
+	const auto QueryTime = std::chrono::steady_clock::now();
+
+	const std::string& Query = Args[1];
+	std::vector<FGuidFixerIndexEntry> Entries;
+	if (Query == "owner" && Args.size() == 3)
+	{
+		FGuidFixerGuid Guid;
+		if (!FGuidFixerGuid::Parse(Args[2], Guid))
+		{
+			std::fprintf(stderr, "%s: not a GUID\n", Args[2].c_str());
+			return 2;
+		}
+		Index.FindOwners(Guid, Entries);
+	}
+	else if (Query == "collisions" && Args.size() <= 3)
+	{
+		Index.FindCollisions(Args.size() == 3 ? Args[2] : std::string(), Entries);
+	}
+	else if (Query == "package" && Args.size() == 3)
+	{
+		Index.FindPackage(Args[2], Entries);
+	}
+	else if (Query == "stats" && Args.size() == 2)
+	{
+		PrintStats(Index.GetStats());
+	}
+	else
+	{
+		return PrintUsage();
+	}
+
+	const auto EndTime = std::chrono::steady_clock::now();
+
+	PrintEntries(Entries);
+	if (bPrintTime)
+	{
+		using FMicroseconds = std::chrono::duration<double, std::micro>;
+		std::fprintf(stderr, "open %.1fus, query %.1fus\n", FMicroseconds(QueryTime - StartTime).count(), FMicroseconds(EndTime - QueryTime).count());
+	}
+	return 0;
+}
@@ -0,0 +1,412 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// guidfixer-stress runs randomized concurrent workloads against GuidFixerCore and checks the results against simple models.
+// It is meant to be built with -DGUIDFIXER_SANITIZER=thread or address, a clean run under both is required before a parallel
+// mode is made the default.
+//
+// Usage: guidfixer-stress [--seconds N] [--threads N] [--seed N]
+
+#include "GuidFixerCollisionDetector.h"
+#include "GuidFixerIndexObjectSource.h"
+#include "GuidFixerIndexReader.h"
+#include "GuidFixerIndexWriter.h"
+#include "GuidFixerSyntheticObjectSource.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+std::atomic<int> NumFailures(0);
+
+void Fail(const char* Workload, const std::string& Message)
+{
+	++NumFailures;
+	std::fprintf(stderr, "FAILED %s: %s\n", Workload, Message.c_str());
+}
+
+using FClock = std::chrono::steady_clock;
+
+/** Parallel detection has to find exactly what the serial detector finds, for any thread count */
+void RunDetection(FClock::time_point EndTime, uint32_t MaxThreads, uint64_t Seed)
+{
+	std::mt19937_64 Random(Seed);
+	uint32_t NumRuns = 0;
+	while (FClock::now() < EndTime)
+	{
+		FGuidFixerSyntheticSourceParams Params;
+		Params.NumRecords = std::uniform_int_distribution<uint64_t>(16384, 1 << 19)(Random);
+		Params.DuplicateRate = std::uniform_real_distribution<double>(0.0, 0.2)(Random);
+		Params.InvalidRate = std::uniform_real_distribution<double>(0.0, 0.05)(Random);
+		Params.ModifiableRate = std::uniform_real_distribution<double>(0.0, 1.0)(Random);
+		Params.Seed = Random();
+		FGuidFixerSyntheticObjectSource Source(Params);
+		std::vector<FGuidFixerScanRecord> Records;
+		Source.ReadAll(Records, std::uniform_int_distribution<size_t>(1, 4096)(Random));
+
+		FGuidFixerResolveOptions Options;
+		const FGuidFixerResolution Serial = FGuidFixerCollisionDetector::Resolve(Records, Options);
+		Options.NumThreads = std::uniform_int_distribution<uint32_t>(2, MaxThreads)(Random);
+		const FGuidFixerResolution Parallel = FGuidFixerCollisionDetector::Resolve(Records, Options);
+
+		bool bSameGroups = Serial.Collisions.size() == Parallel.Collisions.size();
+		for (size_t Group = 0; bSameGroups && Group < Serial.Collisions.size(); ++Group)
+		{
+			bSameGroups = Serial.Collisions[Group].Kind == Parallel.Collisions[Group].Kind
+				&& Serial.Collisions[Group].Guid == Parallel.Collisions[Group].Guid
+				&& Serial.Collisions[Group].Records == Parallel.Collisions[Group].Records
+				&& Serial.Collisions[Group].bResolvable == Parallel.Collisions[Group].bResolvable;
+		}
+		if (!bSameGroups || Serial.ToRegenerate != Parallel.ToRegenerate || Serial.InvalidRecords != Parallel.InvalidRecords)
+		{
+			Fail("Detection", std::to_string(Records.size()) + " records on " + std::to_string(Options.NumThreads) + " threads differ from the serial result");
+		}
+		++NumRuns;
+	}
+	std::printf("Detection: %u runs\n", NumRuns);
+}
+
+/**
+ * An index shared by reader and writer threads. Writers commit packages, invalidate them the way garbage collection drops
+ * unloaded packages, and now and then rebuild the base from everything committed so far. Readers look up and scan meanwhile.
+ * Every change is also appended to a log, which is replayed at the end and has to reproduce the final state.
+ *
+ * Readers take no lock. They load the current snapshot, an immutable reader together with the model it has to match, and
+ * query it while writers publish new ones, so any number of threads run the const lookups of one reader at the same time.
+ * Writers are serialized, each copies the current snapshot, changes the copy and publishes it.
+ */
+class FLiveIndex
+{
+public:
+
+	explicit FLiveIndex(uint32_t NumPackages)
+	{
+		std::map<std::string, std::vector<FGuidFixerTrackedGuid>> Model;
+		for (uint32_t Package = 0; Package < NumPackages; ++Package)
+		{
+			Model["/Game/Live/P" + std::to_string(Package)] = {};
+		}
+		RebuildBase(std::move(Model));
+	}
+
+	void Commit(std::mt19937_64& Random)
+	{
+		const std::lock_guard<std::mutex> Lock(WriteMutex);
+		std::shared_ptr<FSnapshot> Snapshot = std::make_shared<FSnapshot>(*std::atomic_load(&Current));
+		auto Package = std::next(Snapshot->Model.begin(), std::uniform_int_distribution<size_t>(0, Snapshot->Model.size() - 1)(Random));
+
+		std::vector<FGuidFixerTrackedGuid> Guids(std::uniform_int_distribution<size_t>(0, 3)(Random));
+		for (FGuidFixerTrackedGuid& Tracked : Guids)
+		{
+			// A small GUID space, so commits keep creating and resolving collisions
+			Tracked.Kind = EGuidFixerGuidKind(Random() % 2);
+			Tracked.Guid = FGuidFixerGuid{ uint32_t(Random() % 512) + 1, 0, 0, 0 };
+		}
+		Apply(*Snapshot, Package->first, std::move(Guids));
+	}
+
+	void Invalidate(std::mt19937_64& Random)
+	{
+		const std::lock_guard<std::mutex> Lock(WriteMutex);
+		std::shared_ptr<FSnapshot> Snapshot = std::make_shared<FSnapshot>(*std::atomic_load(&Current));
+		auto Package = std::next(Snapshot->Model.begin(), std::uniform_int_distribution<size_t>(0, Snapshot->Model.size() - 1)(Random));
+		Apply(*Snapshot, Package->first, {});
+	}
+
+	void Rebuild()
+	{
+		const std::lock_guard<std::mutex> Lock(WriteMutex);
+		RebuildBase(std::atomic_load(&Current)->Model);
+	}
+
+	/** Checks lookups of the current snapshot against its model, without holding any lock */
+	void Read(std::mt19937_64& Random) const
+	{
+		const std::shared_ptr<const FSnapshot> Snapshot = std::atomic_load(&Current);
+		const FGuidFixerIndexReader& Reader = Snapshot->Reader;
+		auto Package = std::next(Snapshot->Model.begin(), std::uniform_int_distribution<size_t>(0, Snapshot->Model.size() - 1)(Random));
+
+		std::vector<FGuidFixerIndexEntry> Entries;
+		Reader.FindPackage(Package->first, Entries);
+		if (!IsSame(Package->second, Entries))
+		{
+			Fail("LiveIndex", Package->first + " does not match the committed GUIDs");
+		}
+
+		for (const FGuidFixerTrackedGuid& Tracked : Package->second)
+		{
+			Entries.clear();
+			Reader.FindOwners(Tracked.Guid, Entries);
+			if (std::none_of(Entries.begin(), Entries.end(), [&Package](const FGuidFixerIndexEntry& Entry) { return Entry.Package == Package->first; }))
+			{
+				Fail("LiveIndex", Package->first + " is missing from the owners of " + Tracked.Guid.ToString());
+			}
+		}
+
+		if (Random() % 64 == 0)
+		{
+			Entries.clear();
+			Reader.FindCollisions("/Game/Live/P1", Entries);
+
+			FGuidFixerIndexObjectSource Source(Reader, [](const std::string&) { return true; });
+			std::vector<FGuidFixerScanRecord> Records;
+			Source.ReadAll(Records, 64);
+			FGuidFixerCollisionDetector::Resolve(Records, FGuidFixerResolveOptions());
+		}
+	}
+
+	/** Replays the log over the base it was written against, and checks every package */
+	void Verify()
+	{
+		const std::lock_guard<std::mutex> Lock(WriteMutex);
+		const std::shared_ptr<const FSnapshot> Snapshot = std::atomic_load(&Current);
+		FGuidFixerIndexReader Replayed;
+		Replayed.Initialize(Snapshot->BaseData->data(), Snapshot->BaseData->size());
+		Replayed.ReplayLog(LogData.data(), LogData.size());
+
+		std::vector<FGuidFixerIndexEntry> Entries;
+		for (const auto& Package : Snapshot->Model)
+		{
+			Entries.clear();
+			Replayed.FindPackage(Package.first, Entries);
+			if (!IsSame(Package.second, Entries))
+			{
+				Fail("LiveIndex", Package.first + " does not match the committed GUIDs after replaying the log");
+			}
+		}
+		std::printf("LiveIndex: %u commits, %u rebuilds\n", NumCommits, NumRebuilds);
+	}
+
+private:
+
+	/** What a reader sees, never changed once published. The reader views BaseData, which lives as long as any copy of it */
+	struct FSnapshot
+	{
+		std::shared_ptr<const std::vector<uint8_t>> BaseData;
+		FGuidFixerIndexReader Reader;
+		std::map<std::string, std::vector<FGuidFixerTrackedGuid>> Model;
+	};
+
+	void Apply(FSnapshot& Snapshot, const std::string& Package, std::vector<FGuidFixerTrackedGuid> Guids)
+	{
+		Snapshot.Model[Package] = Guids;
+		FGuidFixerIndexWriter::AppendLogRecord({ Package, Guids }, LogData);
+		Snapshot.Reader.SetPackage(Package, std::move(Guids));
+		Publish(Snapshot);
+		++NumCommits;
+	}
+
+	void RebuildBase(std::map<std::string, std::vector<FGuidFixerTrackedGuid>> Model)
+	{
+		std::vector<FGuidFixerIndexPackage> Packages;
+		for (const auto& Package : Model)
+		{
+			Packages.push_back({ Package.first, Package.second });
+		}
+
+		FSnapshot Snapshot;
+		Snapshot.BaseData = std::make_shared<const std::vector<uint8_t>>(FGuidFixerIndexWriter::WriteBase(Packages));
+		Snapshot.Model = std::move(Model);
+		if (!Snapshot.Reader.Initialize(Snapshot.BaseData->data(), Snapshot.BaseData->size()))
+		{
+			Fail("LiveIndex", "rebuilt base does not open");
+		}
+		LogData.clear();
+		Publish(Snapshot);
+		++NumRebuilds;
+	}
+
+	void Publish(FSnapshot& Snapshot)
+	{
+		std::atomic_store(&Current, std::shared_ptr<const FSnapshot>(std::make_shared<FSnapshot>(std::move(Snapshot))));
+	}
+
+	static bool IsSame(std::vector<FGuidFixerTrackedGuid> Expected, const std::vector<FGuidFixerIndexEntry>& Entries)
+	{
+		std::vector<FGuidFixerTrackedGuid> Actual;
+		for (const FGuidFixerIndexEntry& Entry : Entries)
+		{
+			Actual.push_back({ Entry.Kind, Entry.Guid });
+		}
+		const auto Less = [](const FGuidFixerTrackedGuid& Lhs, const FGuidFixerTrackedGuid& Rhs) { return Lhs.Guid < Rhs.Guid || (Lhs.Guid == Rhs.Guid && Lhs.Kind < Rhs.Kind); };
+		std::sort(Expected.begin(), Expected.end(), Less);
+		std::sort(Actual.begin(), Actual.end(), Less);
+		return Expected == Actual;
+	}
+
+	/** Only accessed through std::atomic_load and std::atomic_store */
+	std::shared_ptr<const FSnapshot> Current;
+	/** Serializes writers, and guards everything below */
+	std::mutex WriteMutex;
+	std::vector<uint8_t> LogData;
+	uint32_t NumCommits = 0;
+	uint32_t NumRebuilds = 0;
+};
+
+void RunLiveIndex(FClock::time_point EndTime, uint32_t NumThreads, uint64_t Seed)
+{
+	FLiveIndex Index(2048);
+	std::vector<std::thread> Threads;
+	for (uint32_t Thread = 0; Thread < NumThreads; ++Thread)
+	{
+		Threads.emplace_back([&Index, EndTime, Seed, Thread]()
+		{
+			std::mt19937_64 Random(Seed + Thread);
+			while (FClock::now() < EndTime)
+			{
+				const uint32_t Roll = uint32_t(Random() % 1000);
+				if (Roll < 150)
+				{
+					Index.Commit(Random);
+				}
+				else if (Roll < 180)
+				{
+					Index.Invalidate(Random);
+				}
+				else if (Roll < 181)
+				{
+					Index.Rebuild();
+				}
+				else
+				{
+					Index.Read(Random);
+				}
+			}
+		});
+	}
+	for (std::thread& Thread : Threads)
+	{
+		Thread.join();
+	}
+	Index.Verify();
+}
+
+#if !defined(_WIN32)
+/** Several editors saving at once append to the same log, every record has to survive intact */
+void RunMultiProcessLog(uint32_t NumProcesses, uint64_t Seed)
+{
+	char Filename[] = "/tmp/guidfixer-stress-XXXXXX";
+	const int Descriptor = mkstemp(Filename);
+	if (Descriptor < 0)
+	{
+		Fail("MultiProcessLog", "could not create a temporary log");
+		return;
+	}
+	close(Descriptor);
+
+	// Anything still buffered would be written again by every child
+	std::fflush(stdout);
+
+	const uint32_t NumRecordsPerProcess = 2000;
+	std::vector<pid_t> Children;
+	for (uint32_t Process = 0; Process < NumProcesses; ++Process)
+	{
+		const pid_t Child = fork();
+		if (Child == 0)
+		{
+			// Each record goes out in a single append, which is how the log relies on the OS to keep writers apart
+			std::mt19937_64 Random(Seed + Process);
+			const int Log = open(Filename, O_WRONLY | O_APPEND);
+			for (uint32_t Record = 0; Record < NumRecordsPerProcess; ++Record)
+			{
+				FGuidFixerIndexPackage Package{ "/Game/Process" + std::to_string(Process) + "/P" + std::to_string(Record % 100), {} };
+				Package.Guids.resize(Random() % 8);
+				for (FGuidFixerTrackedGuid& Tracked : Package.Guids)
+				{
+					Tracked.Guid = FGuidFixerGuid{ Process + 1, Record + 1, uint32_t(Random()) | 1, 0 };
+				}
+
+				std::vector<uint8_t> Data;
+				FGuidFixerIndexWriter::AppendLogRecord(Package, Data);
+				if (write(Log, Data.data(), Data.size()) != ssize_t(Data.size()))
+				{
+					_exit(1);
+				}
+			}
+			close(Log);
+			_exit(0);
+		}
+		Children.push_back(Child);
+	}
+
+	for (const pid_t Child : Children)
+	{
+		int Status = 0;
+		waitpid(Child, &Status, 0);
+		if (!WIFEXITED(Status) || WEXITSTATUS(Status) != 0)
+		{
+			Fail("MultiProcessLog", "a writer process failed");
+		}
+	}
+
+	std::ifstream Stream(Filename, std::ios::binary);
+	const std::vector<char> Data((std::istreambuf_iterator<char>(Stream)), std::istreambuf_iterator<char>());
+	std::remove(Filename);
+
+	FGuidFixerIndexReader Reader;
+	const uint32_t NumReplayed = Reader.ReplayLog(reinterpret_cast<const uint8_t*>(Data.data()), Data.size());
+	if (NumReplayed != NumProcesses * NumRecordsPerProcess)
+	{
+		Fail("MultiProcessLog", "replayed " + std::to_string(NumReplayed) + " of " + std::to_string(NumProcesses * NumRecordsPerProcess) + " records");
+	}
+	std::printf("MultiProcessLog: %u records from %u processes\n", NumReplayed, NumProcesses);
+}
+#endif
+}
+
+int main(int ArgC, char** ArgV)
+{
+	double Seconds = 10.0;
+	uint32_t NumThreads = std::max(4u, std::thread::hardware_concurrency());
+	uint64_t Seed = uint64_t(FClock::now().time_since_epoch().count());
+	for (int Arg = 1; Arg + 1 < ArgC; Arg += 2)
+	{
+		const std::string Name = ArgV[Arg];
+		if (Name == "--seconds")
+		{
+			Seconds = std::atof(ArgV[Arg + 1]);
+		}
+		else if (Name == "--threads")
+		{
+			NumThreads = std::max(2u, uint32_t(std::atoi(ArgV[Arg + 1])));
+		}
+		else if (Name == "--seed")
+		{
+			Seed = std::strtoull(ArgV[Arg + 1], nullptr, 10);
+		}
+	}
+	std::printf("Seed %llu, %u threads, %.0fs per workload\n", static_cast<unsigned long long>(Seed), NumThreads, Seconds);
+
+	const auto Duration = std::chrono::duration_cast<FClock::duration>(std::chrono::duration<double>(Seconds));
+	RunDetection(FClock::now() + Duration, NumThreads, Seed);
+	RunLiveIndex(FClock::now() + Duration, NumThreads, Seed);
+#if !defined(_WIN32)
+	RunMultiProcessLog(NumThreads, Seed);
+#endif
+
+	if (NumFailures > 0)
+	{
+		std::fprintf(stderr, "%d failure(s), rerun with --seed %llu\n", NumFailures.load(), static_cast<unsigned long long>(Seed));
+		return 1;
+	}
+	std::printf("OK\n");
+	return 0;
+}
@@ -0,0 +1,508 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// guidfixer-tests checks GuidFixerCore against hand written expectations, it is registered with CTest.
+//
+// Usage: guidfixer-tests
+
+#include "GuidFixerCollisionDetector.h"
+#include "GuidFixerIndexReader.h"
+#include "GuidFixerIndexWriter.h"
+#include "GuidFixerSyntheticObjectSource.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+int NumFailures = 0;
+
+#define GUIDFIXER_CHECK(Condition) Check((Condition), #Condition, __FILE__, __LINE__)
+
+void Check(bool bCondition, const char* Expression, const char* File, int Line)
+{
+	if (!bCondition)
+	{
+		++NumFailures;
+		std::fprintf(stderr, "%s(%d): FAILED %s\n", File, Line, Expression);
+	}
+}
+
+FGuidFixerScanRecord MakeRecord(uint64_t Identity, uint32_t Guid, bool bModifiable, EGuidFixerGuidKind Kind = EGuidFixerGuidKind::MaterialLighting)
+{
+	return { Identity, Kind, FGuidFixerGuid{ Guid, 0, 0, 0 }, bModifiable };
+}
+
+bool AreSame(const FGuidFixerResolution& Lhs, const FGuidFixerResolution& Rhs)
+{
+	if (Lhs.Collisions.size() != Rhs.Collisions.size() || Lhs.InvalidRecords != Rhs.InvalidRecords || Lhs.ToRegenerate != Rhs.ToRegenerate)
+	{
+		return false;
+	}
+	for (size_t Group = 0; Group < Lhs.Collisions.size(); ++Group)
+	{
+		if (Lhs.Collisions[Group].Kind != Rhs.Collisions[Group].Kind
+			|| Lhs.Collisions[Group].Guid != Rhs.Collisions[Group].Guid
+			|| Lhs.Collisions[Group].Records != Rhs.Collisions[Group].Records
+			|| Lhs.Collisions[Group].bResolvable != Rhs.Collisions[Group].bResolvable)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Records sharing a kind and a valid GUID are grouped in scan order, and groups are ordered by their first record */
+void TestGrouping()
+{
+	const std::vector<FGuidFixerScanRecord> Records =
+	{
+		MakeRecord(0, 7, true),
+		MakeRecord(1, 3, true),
+		MakeRecord(2, 7, true, EGuidFixerGuidKind::TextureLighting),
+		MakeRecord(3, 0, true),
+		MakeRecord(4, 5, true),
+		MakeRecord(5, 3, true),
+		MakeRecord(6, 0, true),
+		MakeRecord(7, 7, true),
+		MakeRecord(8, 7, true, EGuidFixerGuidKind::TextureLighting),
+		MakeRecord(9, 5, true, EGuidFixerGuidKind::SoundCompressedData),
+	};
+
+	std::vector<FGuidFixerCollisionGroup> Groups;
+	FGuidFixerCollisionDetector::FindCollisions(Records, Groups);
+
+	// The same GUID under another kind identifies something else, so 7 forms a group per kind and 5 doesn't collide
+	GUIDFIXER_CHECK(Groups.size() == 3);
+	if (Groups.size() == 3)
+	{
+		GUIDFIXER_CHECK(Groups[0].Guid == Records[0].Guid && Groups[0].Kind == EGuidFixerGuidKind::MaterialLighting);
+		GUIDFIXER_CHECK((Groups[0].Records == std::vector<uint32_t>{ 0, 7 }));
+		GUIDFIXER_CHECK(Groups[1].Guid == Records[1].Guid);
+		GUIDFIXER_CHECK((Groups[1].Records == std::vector<uint32_t>{ 1, 5 }));
+		GUIDFIXER_CHECK(Groups[2].Guid == Records[2].Guid && Groups[2].Kind == EGuidFixerGuidKind::TextureLighting);
+		GUIDFIXER_CHECK((Groups[2].Records == std::vector<uint32_t>{ 2, 8 }));
+	}
+
+	// Groups already in the output are kept, new ones are appended after them
+	FGuidFixerCollisionDetector::FindCollisions(Records, Groups);
+	GUIDFIXER_CHECK(Groups.size() == 6);
+
+	std::vector<FGuidFixerCollisionGroup> NoGroups;
+	FGuidFixerCollisionDetector::FindCollisions({ MakeRecord(0, 0, true), MakeRecord(1, 0, true), MakeRecord(2, 1, true) }, NoGroups);
+	GUIDFIXER_CHECK(NoGroups.empty());
+}
+
+/** Partitioning over threads has to find exactly what the serial detector finds */
+void TestPartitioning()
+{
+	FGuidFixerSyntheticSourceParams Params;
+	Params.NumRecords = 200000;
+	Params.DuplicateRate = 0.05;
+	Params.InvalidRate = 0.01;
+	Params.ModifiableRate = 0.7;
+	FGuidFixerSyntheticObjectSource Source(Params);
+	std::vector<FGuidFixerScanRecord> Records;
+	Source.ReadAll(Records);
+
+	FGuidFixerResolveOptions Options;
+	const FGuidFixerResolution Serial = FGuidFixerCollisionDetector::Resolve(Records, Options);
+	GUIDFIXER_CHECK(!Serial.Collisions.empty());
+
+	for (const uint32_t NumThreads : { 2u, 3u, 4u, 8u, 64u })
+	{
+		Options.NumThreads = NumThreads;
+		const FGuidFixerResolution Parallel = FGuidFixerCollisionDetector::Resolve(Records, Options);
+		if (!AreSame(Serial, Parallel))
+		{
+			++NumFailures;
+			std::fprintf(stderr, "FAILED Partitioning: %u threads differ from the serial result\n", NumThreads);
+		}
+	}
+}
+
+/** Only modifiable records are regenerated, and a group is only resolvable with at most one record that isn't */
+void TestResolve()
+{
+	const std::vector<FGuidFixerScanRecord> Records =
+	{
+		MakeRecord(0, 1, false),
+		MakeRecord(1, 1, true),
+		MakeRecord(2, 1, true),
+		MakeRecord(3, 2, false),
+		MakeRecord(4, 2, false),
+		MakeRecord(5, 2, true),
+		MakeRecord(6, 0, true),
+		MakeRecord(7, 0, false),
+		MakeRecord(8, 3, true),
+	};
+
+	FGuidFixerResolveOptions Options;
+	FGuidFixerResolution Resolution = FGuidFixerCollisionDetector::Resolve(Records, Options);
+	GUIDFIXER_CHECK(Resolution.Collisions.size() == 2);
+	if (Resolution.Collisions.size() == 2)
+	{
+		GUIDFIXER_CHECK(Resolution.Collisions[0].bResolvable);
+		GUIDFIXER_CHECK(!Resolution.Collisions[1].bResolvable);
+	}
+	GUIDFIXER_CHECK((Resolution.InvalidRecords == std::vector<uint32_t>{ 6, 7 }));
+	GUIDFIXER_CHECK((Resolution.ToRegenerate == std::vector<uint32_t>{ 1, 2, 5, 6 }));
+	for (const uint32_t Record : Resolution.ToRegenerate)
+	{
+		GUIDFIXER_CHECK(Records[Record].bModifiable);
+	}
+
+	Options.bFixInvalid = false;
+	Resolution = FGuidFixerCollisionDetector::Resolve(Records, Options);
+	GUIDFIXER_CHECK((Resolution.InvalidRecords == std::vector<uint32_t>{ 6, 7 }));
+	GUIDFIXER_CHECK((Resolution.ToRegenerate == std::vector<uint32_t>{ 1, 2, 5 }));
+
+	Options.bFixInvalid = true;
+	Options.bFixDuplicates = false;
+	Resolution = FGuidFixerCollisionDetector::Resolve(Records, Options);
+	GUIDFIXER_CHECK(Resolution.Collisions.empty());
+	GUIDFIXER_CHECK((Resolution.ToRegenerate == std::vector<uint32_t>{ 6 }));
+}
+
+FGuidFixerTrackedGuid MakeTracked(uint32_t Guid, EGuidFixerGuidKind Kind = EGuidFixerGuidKind::MaterialLighting)
+{
+	return { Kind, FGuidFixerGuid{ Guid, 0, 0, 0 } };
+}
+
+/** A corrupt base is rejected by Initialize, rather than read out of bounds or probed forever by lookups */
+void TestCorruptIndex()
+{
+	// A single slot, which is taken so probing it never reaches an empty one, naming a path the dictionary doesn't have
+	{
+		std::vector<uint8_t> Dictionary;
+		FGuidFixerPathDictionary::Build({}, Dictionary);
+		const FGuidFixerIndexSlot Slot = { 1, 2, 3, 4, 5, 0 };
+		const uint32_t Tables[2 + GUIDFIXER_INDEX_MAX_KINDS] = {};
+
+		FGuidFixerIndexHeader Header = {};
+		Header.Magic = GUIDFIXER_INDEX_MAGIC;
+		Header.Version = GUIDFIXER_INDEX_VERSION;
+		Header.NumRecords = 1;
+		Header.NumSlots = 1;
+		Header.SlotsOffset = sizeof(Header);
+		Header.PackageRecordsOffset = Header.SlotsOffset + sizeof(Slot);
+		Header.CollisionsOffset = Header.PackageRecordsOffset + 2 * sizeof(uint32_t);
+		Header.KindCountsOffset = Header.CollisionsOffset;
+		Header.PathDictionaryOffset = Header.KindCountsOffset + GUIDFIXER_INDEX_MAX_KINDS * sizeof(uint32_t);
+		Header.PathDictionarySize = Dictionary.size();
+		Header.FileSize = Header.PathDictionaryOffset + Header.PathDictionarySize;
+
+		std::vector<uint8_t> Data(Header.FileSize);
+		std::memcpy(Data.data(), &Header, sizeof(Header));
+		std::memcpy(Data.data() + Header.SlotsOffset, &Slot, sizeof(Slot));
+		std::memcpy(Data.data() + Header.PackageRecordsOffset, Tables, sizeof(Tables));
+		std::memcpy(Data.data() + Header.PathDictionaryOffset, Dictionary.data(), Dictionary.size());
+
+		FGuidFixerIndexReader Reader;
+		GUIDFIXER_CHECK(!Reader.Initialize(Data.data(), Data.size()));
+		std::vector<FGuidFixerIndexEntry> Entries;
+		Reader.FindOwners(Slot.GetGuid(), Entries);
+		GUIDFIXER_CHECK(Entries.empty());
+	}
+
+	// GUID 3 is owned twice, so the base has a collision list to corrupt as well
+	const std::vector<uint8_t> Valid = FGuidFixerIndexWriter::WriteBase(
+	{
+		{ "/Game/A", { MakeTracked(1), MakeTracked(3) } },
+		{ "/Game/B", { MakeTracked(2), MakeTracked(3) } },
+	});
+	FGuidFixerIndexHeader Header;
+	std::memcpy(&Header, Valid.data(), sizeof(Header));
+	const auto IsAccepted = [](const std::vector<uint8_t>& Data)
+	{
+		FGuidFixerIndexReader Reader;
+		return Reader.Initialize(Data.data(), Data.size());
+	};
+	const auto WithValue = [&Valid](uint64_t Offset, uint32_t Value)
+	{
+		std::vector<uint8_t> Data = Valid;
+		std::memcpy(Data.data() + Offset, &Value, sizeof(Value));
+		return Data;
+	};
+	const auto ReadValue = [&Valid](uint64_t Offset)
+	{
+		uint32_t Value = 0;
+		std::memcpy(&Value, Valid.data() + Offset, sizeof(Value));
+		return Value;
+	};
+	const uint64_t RecordSlotsOffset = Header.PackageRecordsOffset + (Header.NumPaths + 1) * sizeof(uint32_t);
+	const uint32_t FirstSlot = ReadValue(RecordSlotsOffset);
+	uint32_t EmptySlot = 0;
+	while (ReadValue(Header.SlotsOffset + EmptySlot * sizeof(FGuidFixerIndexSlot)) != 0)
+	{
+		++EmptySlot;
+	}
+
+	GUIDFIXER_CHECK(IsAccepted(Valid));
+	GUIDFIXER_CHECK(Header.NumCollisionRecords == 2);
+	GUIDFIXER_CHECK(!IsAccepted(WithValue(Header.SlotsOffset + FirstSlot * sizeof(FGuidFixerIndexSlot) + offsetof(FGuidFixerIndexSlot, PathId), Header.NumPaths)));
+	GUIDFIXER_CHECK(!IsAccepted(WithValue(Header.PackageRecordsOffset, 1)));
+	GUIDFIXER_CHECK(!IsAccepted(WithValue(Header.PackageRecordsOffset + sizeof(uint32_t), Header.NumRecords + 1)));
+	GUIDFIXER_CHECK(!IsAccepted(WithValue(Header.PackageRecordsOffset + Header.NumPaths * sizeof(uint32_t), Header.NumRecords + 1)));
+	GUIDFIXER_CHECK(!IsAccepted(WithValue(RecordSlotsOffset, Header.NumSlots)));
+	GUIDFIXER_CHECK(!IsAccepted(WithValue(Header.CollisionsOffset, Header.NumSlots)));
+	GUIDFIXER_CHECK(!IsAccepted(WithValue(Header.CollisionsOffset, EmptySlot)));
+	GUIDFIXER_CHECK(!IsAccepted(WithValue(offsetof(FGuidFixerIndexHeader, NumRecords), Header.NumSlots / 2 + 1)));
+	GUIDFIXER_CHECK(!IsAccepted(WithValue(offsetof(FGuidFixerIndexHeader, CollisionsOffset) + 4, 0xFFFFFFFF)));
+}
+
+/** @return the packages of Entries, sorted */
+std::vector<std::string> GetPackages(const std::vector<FGuidFixerIndexEntry>& Entries)
+{
+	std::vector<std::string> Packages;
+	for (const FGuidFixerIndexEntry& Entry : Entries)
+	{
+		Packages.push_back(Entry.Package);
+	}
+	std::sort(Packages.begin(), Packages.end());
+	return Packages;
+}
+
+/** IDs, lookups and lower bounds are checked on both sides of every block boundary, for block sizes that split the paths differently */
+void TestPathDictionary()
+{
+	std::vector<std::string> Paths;
+	for (int Index = 49; Index >= 0; --Index)
+	{
+		char Path[16];
+		std::snprintf(Path, sizeof(Path), "/P/%03d", Index);
+		Paths.push_back(Path);
+	}
+	Paths.push_back(Paths.front());
+
+	for (const uint32_t BlockSize : { 1u, 3u, FGuidFixerPathDictionary::DefaultBlockSize })
+	{
+		std::vector<uint8_t> Data;
+		const std::vector<std::string> Sorted = FGuidFixerPathDictionary::Build(Paths, Data, BlockSize);
+		FGuidFixerPathDictionary Dictionary;
+		GUIDFIXER_CHECK(Dictionary.Initialize(Data.data(), Data.size()));
+		GUIDFIXER_CHECK(Sorted.size() == 50 && Dictionary.Num() == 50);
+		GUIDFIXER_CHECK(std::is_sorted(Sorted.begin(), Sorted.end()));
+
+		for (uint32_t PathId = 0; PathId < Sorted.size(); ++PathId)
+		{
+			GUIDFIXER_CHECK(Dictionary.GetPath(PathId) == Sorted[PathId]);
+			GUIDFIXER_CHECK(Dictionary.Find(Sorted[PathId]) == PathId);
+			GUIDFIXER_CHECK(Dictionary.LowerBound(Sorted[PathId]) == PathId);
+			// Sorts right after the path, so lands on the next ID, which is in the next block at the end of one
+			GUIDFIXER_CHECK(Dictionary.LowerBound(Sorted[PathId] + "a") == PathId + 1);
+			GUIDFIXER_CHECK(Dictionary.Find(Sorted[PathId] + "a") == -1);
+		}
+		GUIDFIXER_CHECK(Dictionary.GetPath(Dictionary.Num()).empty());
+		GUIDFIXER_CHECK(Dictionary.LowerBound("") == 0);
+		GUIDFIXER_CHECK(Dictionary.LowerBound("/P/") == 0);
+		GUIDFIXER_CHECK(Dictionary.LowerBound("/Q") == Dictionary.Num());
+		GUIDFIXER_CHECK(Dictionary.Find("/P/") == -1);
+	}
+
+	std::vector<uint8_t> Data;
+	FGuidFixerPathDictionary::Build({}, Data);
+	FGuidFixerPathDictionary Empty;
+	GUIDFIXER_CHECK(Empty.Initialize(Data.data(), Data.size()));
+	GUIDFIXER_CHECK(Empty.Num() == 0 && Empty.LowerBound("/P/000") == 0 && Empty.Find("/P/000") == -1 && Empty.GetPath(0).empty());
+}
+
+/** Everything written to a base reads back through every lookup of the reader */
+void TestIndexRoundTrip()
+{
+	const std::vector<uint8_t> Data = FGuidFixerIndexWriter::WriteBase(
+	{
+		{ "/Game/C", { MakeTracked(1) } },
+		{ "/Game/A", { MakeTracked(1), MakeTracked(2, EGuidFixerGuidKind::TextureLighting) } },
+		{ "/Game/B", { MakeTracked(3), MakeTracked(0) } },
+		{ "/Game/D", { MakeTracked(2) } },
+		{ "/Game/Empty", {} },
+	});
+	FGuidFixerIndexReader Reader;
+	GUIDFIXER_CHECK(Reader.Initialize(Data.data(), Data.size()));
+	GUIDFIXER_CHECK(Reader.NumBasePackages() == 5);
+	GUIDFIXER_CHECK(Reader.GetBasePackagePath(0) == "/Game/A" && Reader.GetBasePackagePath(4) == "/Game/Empty");
+
+	std::vector<FGuidFixerIndexEntry> Entries;
+	Reader.FindOwners(MakeTracked(1).Guid, Entries);
+	GUIDFIXER_CHECK((GetPackages(Entries) == std::vector<std::string>{ "/Game/A", "/Game/C" }));
+
+	Entries.clear();
+	Reader.FindOwners(MakeTracked(0).Guid, Entries);
+	Reader.FindOwners(MakeTracked(4).Guid, Entries);
+	GUIDFIXER_CHECK(Entries.empty());
+
+	Entries.clear();
+	Reader.FindPackage("/Game/A", Entries);
+	GUIDFIXER_CHECK(Entries.size() == 2);
+	if (Entries.size() == 2)
+	{
+		const FGuidFixerIndexEntry& Texture = Entries[0].Guid == MakeTracked(2).Guid ? Entries[0] : Entries[1];
+		GUIDFIXER_CHECK(Texture.Guid == MakeTracked(2).Guid && Texture.Kind == EGuidFixerGuidKind::TextureLighting && Texture.Package == "/Game/A");
+	}
+
+	// Invalid GUIDs aren't written
+	Entries.clear();
+	Reader.FindPackage("/Game/B", Entries);
+	GUIDFIXER_CHECK(Entries.size() == 1 && Entries[0].Guid == MakeTracked(3).Guid);
+
+	Entries.clear();
+	Reader.FindPackage("/Game/Empty", Entries);
+	Reader.FindPackage("/Game/Missing", Entries);
+	Reader.FindBasePackage(Reader.NumBasePackages(), Entries);
+	GUIDFIXER_CHECK(Entries.empty());
+
+	const FGuidFixerIndexStats Stats = Reader.GetStats();
+	GUIDFIXER_CHECK(Stats.NumRecords == 5 && Stats.NumBaseRecords == 5 && Stats.NumPackages == 5);
+	GUIDFIXER_CHECK(Stats.NumCollisionRecords == 2 && Stats.NumLogPackages == 0);
+	GUIDFIXER_CHECK(Stats.KindCounts[uint32_t(EGuidFixerGuidKind::MaterialLighting)] == 4);
+	GUIDFIXER_CHECK(Stats.KindCounts[uint32_t(EGuidFixerGuidKind::TextureLighting)] == 1);
+
+	// GUID 2 is a texture GUID in A and a material GUID in D, which doesn't collide
+	Entries.clear();
+	Reader.FindCollisions("", Entries);
+	GUIDFIXER_CHECK((GetPackages(Entries) == std::vector<std::string>{ "/Game/A", "/Game/C" }));
+	Reader.SetPackage("/Game/New", { MakeTracked(2, EGuidFixerGuidKind::TextureLighting) });
+	Entries.clear();
+	Reader.FindCollisions("/Game/New", Entries);
+	GUIDFIXER_CHECK((GetPackages(Entries) == std::vector<std::string>{ "/Game/A", "/Game/New" }));
+
+	FGuidFixerIndexReader Unset;
+	Entries.clear();
+	Unset.FindOwners(MakeTracked(1).Guid, Entries);
+	Unset.FindPackage("/Game/A", Entries);
+	Unset.FindCollisions("", Entries);
+	GUIDFIXER_CHECK(!Unset.IsValid() && Entries.empty());
+}
+
+/** Collision queries cover exactly the paths under the prefix, whether the range crosses blocks or the prefix ends in 0xFF bytes */
+void TestCollisionPrefix()
+{
+	std::vector<FGuidFixerIndexPackage> Packages;
+	for (uint32_t Index = 0; Index < 40; ++Index)
+	{
+		char Path[32];
+		std::snprintf(Path, sizeof(Path), "/Game/Dir/Pkg%02u", Index);
+		Packages.push_back({ Path, { MakeTracked(1000 + Index) } });
+	}
+	// Pkg15 and Pkg16 are the last and first paths of two blocks
+	Packages[15].Guids.push_back(MakeTracked(100));
+	Packages[16].Guids.push_back(MakeTracked(100));
+	Packages[0].Guids.push_back(MakeTracked(101));
+	Packages[9].Guids.push_back(MakeTracked(101));
+	Packages.push_back({ "/Game/\xFF/A", { MakeTracked(200) } });
+	Packages.push_back({ "/Game/\xFF\xFF/B", { MakeTracked(200) } });
+	Packages.push_back({ "/Game0/C", { MakeTracked(201) } });
+	Packages.push_back({ "/Game/Dir/Pkg20", { MakeTracked(201) } });
+	Packages.push_back({ "\xFF/Y", { MakeTracked(202) } });
+	Packages.push_back({ "\xFF/Z", { MakeTracked(202) } });
+	Packages.erase(Packages.begin() + 20);
+
+	const std::vector<uint8_t> Data = FGuidFixerIndexWriter::WriteBase(Packages);
+	FGuidFixerIndexReader Reader;
+	GUIDFIXER_CHECK(Reader.Initialize(Data.data(), Data.size()));
+
+	const auto FindCollisions = [&Reader](const std::string& Prefix)
+	{
+		std::vector<FGuidFixerIndexEntry> Entries;
+		Reader.FindCollisions(Prefix, Entries);
+		return GetPackages(Entries);
+	};
+	GUIDFIXER_CHECK((FindCollisions("/Game/Dir/Pkg1") == std::vector<std::string>{ "/Game/Dir/Pkg15", "/Game/Dir/Pkg16" }));
+	GUIDFIXER_CHECK((FindCollisions("/Game/Dir/Pkg16") == std::vector<std::string>{ "/Game/Dir/Pkg15", "/Game/Dir/Pkg16" }));
+	GUIDFIXER_CHECK((FindCollisions("/Game/\xFF") == std::vector<std::string>{ "/Game/\xFF/A", "/Game/\xFF\xFF/B" }));
+	GUIDFIXER_CHECK((FindCollisions("\xFF") == std::vector<std::string>{ "\xFF/Y", "\xFF/Z" }));
+	GUIDFIXER_CHECK((FindCollisions("/Game/Dir/Pkg0") == std::vector<std::string>{ "/Game/Dir/Pkg00", "/Game/Dir/Pkg09" }));
+	GUIDFIXER_CHECK(FindCollisions("/Game/Dir/Pkg3").empty());
+	GUIDFIXER_CHECK(FindCollisions("/Other").empty());
+	GUIDFIXER_CHECK(FindCollisions("").size() == 10);
+}
+
+/** Log records replace their package's base entries, and a record cut short anywhere is ignored along with nothing before it */
+void TestReplayLog()
+{
+	const std::vector<uint8_t> Base = FGuidFixerIndexWriter::WriteBase(
+	{
+		{ "/Game/A", { MakeTracked(1) } },
+		{ "/Game/B", { MakeTracked(2) } },
+		{ "/Game/C", { MakeTracked(1) } },
+	});
+
+	std::vector<uint8_t> Log;
+	FGuidFixerIndexWriter::AppendLogRecord({ "/Game/A", { MakeTracked(3) } }, Log);
+	FGuidFixerIndexWriter::AppendLogRecord({ "/Game/New", { MakeTracked(2), MakeTracked(4) } }, Log);
+	const size_t CompleteSize = Log.size();
+	FGuidFixerIndexWriter::AppendLogRecord({ "/Game/B", { MakeTracked(5) } }, Log);
+
+	for (size_t Size = CompleteSize; Size < Log.size(); ++Size)
+	{
+		FGuidFixerIndexReader Reader;
+		GUIDFIXER_CHECK(Reader.Initialize(Base.data(), Base.size()));
+		if (Reader.ReplayLog(Log.data(), Size) != 2)
+		{
+			++NumFailures;
+			std::fprintf(stderr, "FAILED ReplayLog: log cut to %zu of %zu bytes\n", Size, Log.size());
+			continue;
+		}
+		GUIDFIXER_CHECK(!Reader.HasLogPackage("/Game/B"));
+
+		std::vector<FGuidFixerIndexEntry> Entries;
+		Reader.FindOwners(MakeTracked(1).Guid, Entries);
+		GUIDFIXER_CHECK((GetPackages(Entries) == std::vector<std::string>{ "/Game/C" }));
+		Entries.clear();
+		Reader.FindOwners(MakeTracked(2).Guid, Entries);
+		GUIDFIXER_CHECK((GetPackages(Entries) == std::vector<std::string>{ "/Game/B", "/Game/New" }));
+		Entries.clear();
+		Reader.FindOwners(MakeTracked(5).Guid, Entries);
+		GUIDFIXER_CHECK(Entries.empty());
+	}
+
+	FGuidFixerIndexReader Reader;
+	GUIDFIXER_CHECK(Reader.Initialize(Base.data(), Base.size()));
+	GUIDFIXER_CHECK(Reader.ReplayLog(Log.data(), Log.size()) == 3);
+	GUIDFIXER_CHECK((Reader.GetLogPackages() == std::vector<std::string>{ "/Game/A", "/Game/B", "/Game/New" }));
+
+	// The base entries of a package in the log are masked in every lookup
+	std::vector<FGuidFixerIndexEntry> Entries;
+	Reader.FindBasePackage(0, Entries);
+	GUIDFIXER_CHECK(Entries.empty());
+	Reader.FindPackage("/Game/A", Entries);
+	GUIDFIXER_CHECK(Entries.size() == 1 && Entries[0].Guid == MakeTracked(3).Guid);
+	Entries.clear();
+	Reader.FindOwners(MakeTracked(2).Guid, Entries);
+	GUIDFIXER_CHECK((GetPackages(Entries) == std::vector<std::string>{ "/Game/New" }));
+	Entries.clear();
+	Reader.FindCollisions("/Game/", Entries);
+	GUIDFIXER_CHECK(Entries.empty());
+
+	const FGuidFixerIndexStats Stats = Reader.GetStats();
+	GUIDFIXER_CHECK(Stats.NumRecords == 5 && Stats.NumBaseRecords == 3 && Stats.NumPackages == 4 && Stats.NumLogPackages == 3);
+
+	// A record with a bad magic ends the replay like a truncated one
+	Log[CompleteSize] ^= 0xFF;
+	FGuidFixerIndexReader Corrupt;
+	GUIDFIXER_CHECK(Corrupt.ReplayLog(Log.data(), Log.size()) == 2);
+}
+}
+
+int main()
+{
+	TestGrouping();
+	TestPartitioning();
+	TestResolve();
+	TestPathDictionary();
+	TestIndexRoundTrip();
+	TestCollisionPrefix();
+	TestReplayLog();
+	TestCorruptIndex();
+
+	if (NumFailures > 0)
+	{
+		std::fprintf(stderr, "%d failure(s)\n", NumFailures);
+		return 1;
+	}
+	std::printf("OK\n");
+	return 0;
+}